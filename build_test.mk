@@ -50,7 +50,14 @@ endif
 include common_features.mk
 include $(TMK_PATH)/common.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/leader/tests/rules.mk
+include $(QUANTUM_PATH)/debounce/tests/rules.mk
+include $(TMK_PATH)/protocol/arm_atsam/tests/rules.mk
 include $(QUANTUM_PATH)/serial_link/tests/rules.mk
+include $(QUANTUM_PATH)/audio/tests/rules.mk
+include $(QUANTUM_PATH)/encoder/tests/rules.mk
+include $(QUANTUM_PATH)/mousekey/tests/rules.mk
+include $(TMK_PATH)/common/tests/rules.mk
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include build_full_test.mk
 endif
@@ -51,6 +51,7 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
         else ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
+            SRC += $(QUANTUM_DIR)/audio/wavetable_synth.c
         ## stm32f2 and above have a usable DAC unit, f1 do not, and need to use pwm instead
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_software)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
@@ -70,6 +71,7 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/audio/driver_$(PLATFORM_KEY)_$(strip $(AUDIO_DRIVER)).c
     SRC += $(QUANTUM_DIR)/audio/voices.c
     SRC += $(QUANTUM_DIR)/audio/luts.c
+    SRC += $(QUANTUM_DIR)/audio/encoded_song.c
 endif
 
 ifeq ($(strip $(SEQUENCER_ENABLE)), yes)
@@ -103,7 +105,9 @@ endif
 ifeq ($(strip $(MOUSEKEY_ENABLE)), yes)
     OPT_DEFS += -DMOUSEKEY_ENABLE
     OPT_DEFS += -DMOUSE_ENABLE
+    COMMON_VPATH += $(QUANTUM_DIR)/mousekey
     SRC += $(QUANTUM_DIR)/mousekey.c
+    SRC += $(QUANTUM_DIR)/mousekey/mousekey_physics.c
 endif
 
 ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
@@ -316,7 +320,8 @@ ifeq ($(strip $(PRINTING_ENABLE)), yes)
 endif
 
 ifeq ($(strip $(SERIAL_LINK_ENABLE)), yes)
-    SERIAL_SRC := $(wildcard $(SERIAL_PATH)/protocol/*.c)
+    # duplex_link.c belongs to the usart_duplex split driver
+    SERIAL_SRC := $(filter-out $(SERIAL_PATH)/protocol/duplex_link.c, $(wildcard $(SERIAL_PATH)/protocol/*.c))
     SERIAL_SRC += $(wildcard $(SERIAL_PATH)/system/*.c)
     SERIAL_DEFS += -DSERIAL_LINK_ENABLE
     COMMON_VPATH += $(SERIAL_PATH)
@@ -432,7 +437,12 @@ ifeq ($(strip $(WPM_ENABLE)), yes)
 endif
 
 ifeq ($(strip $(ENCODER_ENABLE)), yes)
+    COMMON_VPATH += $(QUANTUM_DIR)/encoder
     SRC += $(QUANTUM_DIR)/encoder.c
+    SRC += $(QUANTUM_DIR)/encoder/encoder_queue.c
+    ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
+        SRC += $(QUANTUM_DIR)/encoder/encoder_log.c
+    endif
     OPT_DEFS += -DENCODER_ENABLE
 endif
 
@@ -526,6 +536,12 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         else
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
         endif
+        ifeq ($(strip $(SERIAL_DRIVER)), usart_duplex)
+            QUANTUM_LIB_SRC += serial_link/protocol/byte_stuffer.c \
+                               serial_link/protocol/frame_validator.c \
+                               serial_link/protocol/crc.c \
+                               serial_link/protocol/duplex_link.c
+        endif
     endif
     COMMON_VPATH += $(QUANTUM_PATH)/split_common
 endif
@@ -625,6 +641,10 @@ endif
 ifeq ($(strip $(LEADER_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_leader.c
     OPT_DEFS += -DLEADER_ENABLE
+    ifeq ($(strip $(LEADER_TRIE_ENABLE)), yes)
+        SRC += $(QUANTUM_DIR)/leader/leader_trie.c
+        OPT_DEFS += -DLEADER_TRIE_ENABLE
+    endif
 endif
 
 ifeq ($(strip $(AUTO_SHIFT_ENABLE)), yes)
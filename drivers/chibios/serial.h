@@ -47,6 +47,24 @@ int soft_serial_transaction(void);
 int soft_serial_transaction(int sstd_index);
 #endif
 
+#if defined(SERIAL_DRIVER_USART) || defined(SERIAL_DRIVER_USART_DUPLEX)
+// usart and usart_duplex drivers only: runs a transaction in the background,
+// soft_serial_transaction_wait() returns its initiator result
+#    ifndef SERIAL_USE_MULTI_TRANSACTION
+void soft_serial_transaction_start(void);
+#    else
+void soft_serial_transaction_start(int sstd_index);
+#    endif
+int soft_serial_transaction_wait(void);
+#endif
+
+#ifdef SERIAL_DRIVER_USART_DUPLEX
+// usart_duplex driver only: counts since startup of the requests sent again,
+// and of the requests never answered plus the frames that fit no transaction
+uint32_t soft_serial_get_retries(void);
+uint32_t soft_serial_get_errors(void);
+#endif
+
 // target status
 // *SSTD_t.status has
 //   initiator:
@@ -163,14 +163,15 @@ void handle_soft_serial_slave(void) {
     uint8_t sstd_index = sdGet(&SERIAL_USART_DRIVER);  // first chunk is always transaction id
     SSTD_t* trans      = &Transaction_table[sstd_index];
 
-    // Always write back the sstd_index as part of a basic handshake
-    sstd_index ^= HANDSHAKE_MAGIC;
-    sdWrite(&SERIAL_USART_DRIVER, &sstd_index, sizeof(sstd_index));
-
+    // The initiator sends its data right after the transaction id, without waiting for the handshake
     if (trans->initiator2target_buffer_size) {
         sdRead(&SERIAL_USART_DRIVER, trans->initiator2target_buffer, trans->initiator2target_buffer_size);
     }
 
+    // Always write back the sstd_index as part of a basic handshake
+    sstd_index ^= HANDSHAKE_MAGIC;
+    sdWrite(&SERIAL_USART_DRIVER, &sstd_index, sizeof(sstd_index));
+
     if (trans->target2initiator_buffer_size) {
         sdWrite(&SERIAL_USART_DRIVER, trans->target2initiator_buffer, trans->target2initiator_buffer_size);
     }
@@ -180,51 +181,79 @@ void handle_soft_serial_slave(void) {
     }
 }
 
+static SSTD_t* pending_trans  = NULL;
+static bool    pending_queued = false;
+
+// Whether the whole transaction fits in the input queue, along with the echo of what the initiator sends
+static bool fits_in_queues(SSTD_t* trans) {
+    uint16_t initiator_bytes = 1 + trans->initiator2target_buffer_size;
+    uint16_t target_bytes    = 1 + trans->target2initiator_buffer_size;
+    return initiator_bytes + target_bytes <= SERIAL_BUFFERS_SIZE;
+}
+
 /////////
-//  start transaction by initiator
+//  start transaction by initiator, in the background
 //
-// int  soft_serial_transaction(int sstd_index)
+// void soft_serial_transaction_start(int sstd_index)
 //
-// Returns:
-//    TRANSACTION_END
-//    TRANSACTION_NO_RESPONSE
-//    TRANSACTION_DATA_ERROR
+// Queues the transaction id and the initiator's data, which the driver sends
+// and receives the answer to from its interrupts, while the initiator gets on
+// with other work. soft_serial_transaction_wait() then collects the answer.
+// Transactions too large for the driver's queues are run by
+// soft_serial_transaction_wait() instead.
 #ifndef SERIAL_USE_MULTI_TRANSACTION
-int soft_serial_transaction(void) {
+void soft_serial_transaction_start(void) {
     uint8_t sstd_index = 0;
 #else
-int soft_serial_transaction(int index) {
+void soft_serial_transaction_start(int index) {
     uint8_t sstd_index = index;
 #endif
 
-    if (sstd_index > Transaction_table_size) return TRANSACTION_TYPE_ERROR;
-    SSTD_t* trans = &Transaction_table[sstd_index];
-    msg_t   res   = 0;
+    pending_trans  = NULL;
+    pending_queued = false;
+    if (sstd_index > Transaction_table_size) return;
+    pending_trans = &Transaction_table[sstd_index];
+
+    if (!fits_in_queues(pending_trans)) return;
+
+    sdClear(&SERIAL_USART_DRIVER);
+
+    // Not the half duplex sdWriteTimeout, the echo is read back by soft_serial_transaction_wait()
+    chnWriteTimeout(&SERIAL_USART_DRIVER, &sstd_index, sizeof(sstd_index), TIME_MS2I(SERIAL_USART_TIMEOUT));
+    if (pending_trans->initiator2target_buffer_size) {
+        chnWriteTimeout(&SERIAL_USART_DRIVER, pending_trans->initiator2target_buffer, pending_trans->initiator2target_buffer_size, TIME_MS2I(SERIAL_USART_TIMEOUT));
+    }
+    pending_queued = true;
+}
 
+static int transaction_send(SSTD_t* trans, uint8_t sstd_index) {
     sdClear(&SERIAL_USART_DRIVER);
 
     // First chunk is always transaction id
     sdWriteTimeout(&SERIAL_USART_DRIVER, &sstd_index, sizeof(sstd_index), TIME_MS2I(SERIAL_USART_TIMEOUT));
 
+    if (trans->initiator2target_buffer_size) {
+        msg_t res = sdWriteTimeout(&SERIAL_USART_DRIVER, trans->initiator2target_buffer, trans->initiator2target_buffer_size, TIME_MS2I(SERIAL_USART_TIMEOUT));
+        if (res < 0) {
+            dprintf("serial::usart_transmit NO_RESPONSE\n");
+            return TRANSACTION_NO_RESPONSE;
+        }
+    }
+    return TRANSACTION_END;
+}
+
+static int transaction_receive(SSTD_t* trans, uint8_t sstd_index) {
     uint8_t sstd_index_shake = 0xFF;
 
     // Which we always read back first so that we can error out correctly
     //   - due to the half duplex limitations on return codes, we always have to read *something*
     //   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready
-    res = sdReadTimeout(&SERIAL_USART_DRIVER, &sstd_index_shake, sizeof(sstd_index_shake), TIME_MS2I(SERIAL_USART_TIMEOUT));
+    msg_t res = sdReadTimeout(&SERIAL_USART_DRIVER, &sstd_index_shake, sizeof(sstd_index_shake), TIME_MS2I(SERIAL_USART_TIMEOUT));
     if (res < 0 || (sstd_index_shake != (sstd_index ^ HANDSHAKE_MAGIC))) {
         dprintf("serial::usart_shake NO_RESPONSE\n");
         return TRANSACTION_NO_RESPONSE;
     }
 
-    if (trans->initiator2target_buffer_size) {
-        res = sdWriteTimeout(&SERIAL_USART_DRIVER, trans->initiator2target_buffer, trans->initiator2target_buffer_size, TIME_MS2I(SERIAL_USART_TIMEOUT));
-        if (res < 0) {
-            dprintf("serial::usart_transmit NO_RESPONSE\n");
-            return TRANSACTION_NO_RESPONSE;
-        }
-    }
-
     if (trans->target2initiator_buffer_size) {
         res = sdReadTimeout(&SERIAL_USART_DRIVER, trans->target2initiator_buffer, trans->target2initiator_buffer_size, TIME_MS2I(SERIAL_USART_TIMEOUT));
         if (res < 0) {
@@ -235,3 +264,59 @@ int soft_serial_transaction(int index) {
 
     return TRANSACTION_END;
 }
+
+/////////
+//  finish the transaction started by soft_serial_transaction_start()
+//
+// int  soft_serial_transaction_wait(void)
+//
+// Returns:
+//    TRANSACTION_END
+//    TRANSACTION_NO_RESPONSE
+//    TRANSACTION_TYPE_ERROR
+int soft_serial_transaction_wait(void) {
+    SSTD_t* trans = pending_trans;
+    if (!trans) return TRANSACTION_TYPE_ERROR;
+    pending_trans = NULL;
+
+    uint8_t sstd_index = trans - Transaction_table;
+    if (!pending_queued) {
+        int res = transaction_send(trans, sstd_index);
+        if (res != TRANSACTION_END) return res;
+    } else {
+        // Half duplex reads back the data sent in the background - just throw it away
+        uint8_t dump[1 + trans->initiator2target_buffer_size];
+        if (sdReadTimeout(&SERIAL_USART_DRIVER, dump, sizeof(dump), TIME_MS2I(SERIAL_USART_TIMEOUT)) < (msg_t)sizeof(dump)) {
+            dprintf("serial::usart_transmit NO_RESPONSE\n");
+            return TRANSACTION_NO_RESPONSE;
+        }
+    }
+
+    return transaction_receive(trans, sstd_index);
+}
+
+/////////
+//  start transaction by initiator
+//
+// int  soft_serial_transaction(int sstd_index)
+//
+// Returns:
+//    TRANSACTION_END
+//    TRANSACTION_NO_RESPONSE
+//    TRANSACTION_DATA_ERROR
+#ifndef SERIAL_USE_MULTI_TRANSACTION
+int soft_serial_transaction(void) {
+    uint8_t sstd_index = 0;
+#else
+int soft_serial_transaction(int index) {
+    uint8_t sstd_index = index;
+#endif
+
+    if (sstd_index > Transaction_table_size) return TRANSACTION_TYPE_ERROR;
+    SSTD_t* trans = &Transaction_table[sstd_index];
+
+    int res = transaction_send(trans, sstd_index);
+    if (res != TRANSACTION_END) return res;
+
+    return transaction_receive(trans, sstd_index);
+}
@@ -0,0 +1,304 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+#include "serial.h"
+#include "print.h"
+#include "serial_link/protocol/byte_stuffer.h"
+#include "serial_link/protocol/frame_router.h"
+#include "serial_link/protocol/duplex_link.h"
+
+#include <ch.h>
+#include <hal.h>
+
+/*
+ * Full duplex split transport on a ChibiOS UART driver. The transactions are
+ * framed and checked by the serial_link protocol, see duplex_link.h. Frames are
+ * sent by DMA; they differ in length, so they are received a character at a
+ * time into an input queue.
+ */
+
+#ifndef USE_GPIOV1
+// The default PAL alternate modes are used to signal that the pins are used for USART
+#    ifndef SERIAL_USART_TX_PAL_MODE
+#        define SERIAL_USART_TX_PAL_MODE 7
+#    endif
+#    ifndef SERIAL_USART_RX_PAL_MODE
+#        define SERIAL_USART_RX_PAL_MODE 7
+#    endif
+#endif
+
+#ifndef SERIAL_USART_DRIVER
+#    define SERIAL_USART_DRIVER UARTD1
+#endif
+
+// 8 bits without parity, the frames have a CRC
+#ifndef SERIAL_USART_CR1
+#    define SERIAL_USART_CR1 0
+#endif
+
+#ifndef SERIAL_USART_CR2
+#    define SERIAL_USART_CR2 0
+#endif
+
+#ifndef SERIAL_USART_CR3
+#    define SERIAL_USART_CR3 0
+#endif
+
+#ifdef SOFT_SERIAL_PIN
+#    define SERIAL_USART_TX_PIN SOFT_SERIAL_PIN
+#endif
+
+#ifndef SERIAL_USART_RX_PIN
+#    error "The usart_duplex driver needs SERIAL_USART_RX_PIN"
+#endif
+
+#ifndef SERIAL_USART_SPEED
+#    define SERIAL_USART_SPEED 2000000
+#endif
+
+// Milliseconds to wait for the answer to a request, before sending it again
+#ifndef SERIAL_USART_TIMEOUT
+#    define SERIAL_USART_TIMEOUT 5
+#endif
+
+#ifndef SERIAL_USART_RETRIES
+#    define SERIAL_USART_RETRIES 3
+#endif
+
+// Milliseconds between the slave's checks for data to push
+#ifndef SERIAL_USART_PUSH_INTERVAL
+#    define SERIAL_USART_PUSH_INTERVAL 1
+#endif
+
+#ifndef SERIAL_USART_RX_QUEUE_SIZE
+#    define SERIAL_USART_RX_QUEUE_SIZE 512
+#endif
+
+// Only one link, both ways
+#define DUPLEX_LINK 0
+
+static duplex_link_t duplex;
+
+static uint8_t       rx_buffer[SERIAL_USART_RX_QUEUE_SIZE];
+static input_queue_t rx_queue;
+// Bytes lost because the queue was full, counted as errors
+static volatile uint32_t rx_overflows = 0;
+
+// A byte stuffed frame grows by a byte for every 254 bytes, plus the one at each end
+static uint8_t  tx_buffer[DUPLEX_LINK_FRAME_SIZE + DUPLEX_LINK_FRAME_SIZE / 254 + 2];
+static uint16_t tx_size = 0;
+
+static void usart_rxchar(UARTDriver* uartp, uint16_t c) {
+    (void)uartp;
+
+    chSysLockFromISR();
+    if (iqIsFullI(&rx_queue)) {
+        rx_overflows++;
+    } else {
+        iqPutI(&rx_queue, (uint8_t)c);
+    }
+    chSysUnlockFromISR();
+}
+
+static UARTConfig uartcfg = {
+    .rxchar_cb = usart_rxchar,
+    .speed     = (SERIAL_USART_SPEED),
+    .cr1       = (SERIAL_USART_CR1),
+    .cr2       = (SERIAL_USART_CR2),
+    .cr3       = (SERIAL_USART_CR3),
+};
+
+// The byte stuffer sends a frame in pieces, which are collected for a single DMA transfer
+void send_data(uint8_t link, const uint8_t* data, uint16_t size) {
+    (void)link;
+
+    if (tx_size + size > sizeof(tx_buffer)) {
+        return;
+    }
+    memcpy(&tx_buffer[tx_size], data, size);
+    tx_size += size;
+}
+
+// The duplex link parses the frames itself, so they are received in the byte stuffer's buffer
+uint8_t* route_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity) { return NULL; }
+
+void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) {
+    (void)link;
+
+    duplex_link_recv_frame(&duplex, data, size);
+}
+
+static void flush(void) {
+    if (tx_size) {
+        size_t size = tx_size;
+        uartSendFullTimeout(&SERIAL_USART_DRIVER, &size, tx_buffer, TIME_MS2I(SERIAL_USART_TIMEOUT));
+        tx_size = 0;
+    }
+}
+
+/*
+ * This thread runs on the slave, answers the master's requests and pushes
+ * the changes of the slave's data
+ */
+static THD_WORKING_AREA(waSlaveThread, 1024);
+static THD_FUNCTION(SlaveThread, arg) {
+    (void)arg;
+    chRegSetThreadName("slave_transport");
+
+    systime_t last_push = chVTGetSystemTimeX();
+    while (true) {
+        msg_t c = iqGetTimeout(&rx_queue, TIME_MS2I(SERIAL_USART_PUSH_INTERVAL));
+        if (c >= MSG_OK) {
+            byte_stuffer_recv_byte(DUPLEX_LINK, (uint8_t)c);
+        }
+
+        if (chVTTimeElapsedSinceX(last_push) >= TIME_MS2I(SERIAL_USART_PUSH_INTERVAL)) {
+            duplex_link_push(&duplex);
+            last_push = chVTGetSystemTimeX();
+        }
+        flush();
+    }
+}
+
+__attribute__((weak)) void usart_init(void) {
+#if defined(USE_GPIOV1)
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_STM32_ALTERNATE_PUSHPULL);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_INPUT);
+#else
+    palSetLineMode(SERIAL_USART_TX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_TX_PAL_MODE) | PAL_STM32_OTYPE_PUSHPULL);
+    palSetLineMode(SERIAL_USART_RX_PIN, PAL_MODE_ALTERNATE(SERIAL_USART_RX_PAL_MODE) | PAL_STM32_PUPDR_PULLUP);
+#endif
+}
+
+static void usart_duplex_init(SSTD_t* sstd_table, int sstd_table_size) {
+    duplex_link_init(&duplex, DUPLEX_LINK, sstd_table, (uint8_t)sstd_table_size);
+    init_byte_stuffer();
+    iqObjectInit(&rx_queue, rx_buffer, sizeof(rx_buffer), NULL, NULL);
+
+    usart_init();
+    uartStart(&SERIAL_USART_DRIVER, &uartcfg);
+}
+
+void soft_serial_initiator_init(SSTD_t* sstd_table, int sstd_table_size) { usart_duplex_init(sstd_table, sstd_table_size); }
+
+void soft_serial_target_init(SSTD_t* sstd_table, int sstd_table_size) {
+    usart_duplex_init(sstd_table, sstd_table_size);
+
+    // Start transport thread
+    chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
+}
+
+uint32_t soft_serial_get_retries(void) { return duplex.stats.retries; }
+
+uint32_t soft_serial_get_errors(void) { return duplex.stats.errors + rx_overflows; }
+
+static uint8_t pending_index = DUPLEX_LINK_NONE;
+
+/////////
+//  start transaction by initiator, in the background
+//
+// void soft_serial_transaction_start(int sstd_index)
+//
+// Sends the request, soft_serial_transaction_wait() then waits for its answer.
+#ifndef SERIAL_USE_MULTI_TRANSACTION
+void soft_serial_transaction_start(void) {
+    uint8_t sstd_index = 0;
+#else
+void soft_serial_transaction_start(int index) {
+    uint8_t sstd_index = index;
+#endif
+
+    pending_index = DUPLEX_LINK_NONE;
+
+    // The pushes received since the last transaction are only read while waiting for an answer, so after a long
+    // scan they may be stale or cut short by an overflow. The answer carries the data anyway, so drop them.
+    chSysLock();
+    iqResetI(&rx_queue);
+    chSysUnlock();
+    init_byte_stuffer();
+
+    if (!duplex_link_request(&duplex, sstd_index, false)) return;
+    pending_index = sstd_index;
+    flush();
+}
+
+// Handles what the slave sent, answers and pushes alike, until the answer to the request arrives
+static bool wait_for_answer(void) {
+    systime_t start = chVTGetSystemTimeX();
+
+    while (!duplex_link_answered(&duplex)) {
+        sysinterval_t elapsed = chVTTimeElapsedSinceX(start);
+        if (elapsed >= TIME_MS2I(SERIAL_USART_TIMEOUT)) {
+            return false;
+        }
+
+        msg_t c = iqGetTimeout(&rx_queue, TIME_MS2I(SERIAL_USART_TIMEOUT) - elapsed);
+        if (c < MSG_OK) {
+            return false;
+        }
+        byte_stuffer_recv_byte(DUPLEX_LINK, (uint8_t)c);
+    }
+    return true;
+}
+
+/////////
+//  finish the transaction started by soft_serial_transaction_start()
+//
+// int  soft_serial_transaction_wait(void)
+//
+// Returns:
+//    TRANSACTION_END
+//    TRANSACTION_NO_RESPONSE
+//    TRANSACTION_TYPE_ERROR
+int soft_serial_transaction_wait(void) {
+    uint8_t sstd_index = pending_index;
+    if (sstd_index == DUPLEX_LINK_NONE) return TRANSACTION_TYPE_ERROR;
+    pending_index = DUPLEX_LINK_NONE;
+
+    for (uint8_t retries = 0; !wait_for_answer(); retries++) {
+        if (retries == SERIAL_USART_RETRIES) {
+            duplex_link_fail(&duplex);
+            dprintf("serial::usart_duplex NO_RESPONSE\n");
+            return TRANSACTION_NO_RESPONSE;
+        }
+
+        duplex_link_request(&duplex, sstd_index, true);
+        flush();
+    }
+
+    return TRANSACTION_END;
+}
+
+/////////
+//  start transaction by initiator
+//
+// int  soft_serial_transaction(int sstd_index)
+//
+// Returns:
+//    TRANSACTION_END
+//    TRANSACTION_NO_RESPONSE
+//    TRANSACTION_TYPE_ERROR
+#ifndef SERIAL_USE_MULTI_TRANSACTION
+int soft_serial_transaction(void) {
+    soft_serial_transaction_start();
+#else
+int soft_serial_transaction(int index) {
+    soft_serial_transaction_start(index);
+#endif
+
+    return soft_serial_transaction_wait();
+}
@@ -1,6 +1,8 @@
 #include "ws2812.h"
 #include "quantum.h"
+#include <ch.h>
 #include <hal.h>
+#include <string.h>
 
 /* Adapted from https://github.com/joewa/WS2812-LED-Driver_ChibiOS/ */
 
@@ -63,6 +65,20 @@
 #define WS2812_COLOR_BIT_N (RGBLED_NUM * 24)                   /**< Number of data bits */
 #define WS2812_BIT_N (WS2812_COLOR_BIT_N + WS2812_RESET_BIT_N) /**< Total number of bits in a frame */
 
+/**
+ * @brief   Index of the first color bit in a frame
+ *
+ * When double buffering, the reset period goes first, so that the DMA is sending zeroes while
+ * the next frame is swapped in at the end of the previous one.
+ */
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+#    define WS2812_COLOR_BIT_START WS2812_RESET_BIT_N
+#    define WS2812_RESET_BIT_START 0
+#else
+#    define WS2812_COLOR_BIT_START 0
+#    define WS2812_RESET_BIT_START WS2812_COLOR_BIT_N
+#endif
+
 /**
  * @brief   High period for a zero, in ticks
  *
@@ -105,7 +121,7 @@
  *
  * @return                          The bit index
  */
-#define WS2812_BIT(led, byte, bit) (24 * (led) + 8 * (byte) + (7 - (bit)))
+#define WS2812_BIT(led, byte, bit) (WS2812_COLOR_BIT_START + 24 * (led) + 8 * (byte) + (7 - (bit)))
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
 /**
@@ -219,22 +235,92 @@
 #    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 0, (bit))
 #endif
 
+/**
+ * @brief   Frame buffer words for the four bits of a nibble, most significant bit first
+ */
+#define WS2812_NIBBLE(n) \
+    { ((n)&0x8) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0, ((n)&0x4) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0, ((n)&0x2) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0, ((n)&0x1) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0 }
+
+#ifndef WS2812_ENCODE_REPORT_INTERVAL
+#    define WS2812_ENCODE_REPORT_INTERVAL 1000  // How often the frame encode time is printed to the debug console, in ms
+#endif
+
 /* --- PRIVATE VARIABLES ---------------------------------------------------- */
 
+/**
+ * @brief   Lookup table from a nibble to its four frame buffer words, so each byte is encoded
+ *          with two table lookups instead of a branch per bit
+ */
+static const uint32_t ws2812_nibble_lut[16][4] = {
+    WS2812_NIBBLE(0x0), WS2812_NIBBLE(0x1), WS2812_NIBBLE(0x2), WS2812_NIBBLE(0x3), WS2812_NIBBLE(0x4), WS2812_NIBBLE(0x5), WS2812_NIBBLE(0x6), WS2812_NIBBLE(0x7),
+    WS2812_NIBBLE(0x8), WS2812_NIBBLE(0x9), WS2812_NIBBLE(0xA), WS2812_NIBBLE(0xB), WS2812_NIBBLE(0xC), WS2812_NIBBLE(0xD), WS2812_NIBBLE(0xE), WS2812_NIBBLE(0xF),
+};
+
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+static uint32_t           ws2812_frame_buffers[2][WS2812_BIT_N + 1]; /**< Buffers for the frame being sent and the next one */
+static uint32_t* volatile ws2812_frame_buffer = ws2812_frame_buffers[1]; /**< Buffer for the next frame, not read by the DMA */
+static volatile bool      ws2812_frame_pending;                          /**< The next frame is ready to be swapped in */
+#else
 static uint32_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
+#endif
 
-/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
-/*
- * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
-the memory (while the DMA is reading/writing from/to a buffer, the application can
-write/read to/from the other buffer).
+/* --- PRIVATE FUNCTIONS ---------------------------------------------------- */
+
+#define WS2812_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3))
+
+static inline void ws2812_encode_byte(uint32_t* dest, uint8_t byte) {
+    memcpy(dest, ws2812_nibble_lut[byte >> 4], sizeof(ws2812_nibble_lut[0]));
+    memcpy(dest + 4, ws2812_nibble_lut[byte & 0x0F], sizeof(ws2812_nibble_lut[0]));
+}
+
+// Cycle counter where the core has one, as the system tick is too coarse for a frame
+#if PORT_SUPPORTS_RT == TRUE
+static inline uint32_t ws2812_time_start(void) { return chSysGetRealtimeCounterX(); }
+static inline uint32_t ws2812_time_elapsed_us(uint32_t start) { return RTC2US(STM32_HCLK, chSysGetRealtimeCounterX() - start); }
+#else
+static inline uint32_t ws2812_time_start(void) { return timer_read_us32(); }
+static inline uint32_t ws2812_time_elapsed_us(uint32_t start) { return timer_elapsed_us32(start); }
+#endif
+
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+/**
+ * @brief   Swaps in the next frame once the current one has been sent
+ *
+ * The transfer complete interrupt fires after the last color bit, while the timer goes on to the
+ * reset period at the start of the buffer, so the swap only lengthens the reset period. Should the
+ * swap miss an update event, the last bit is repeated once, which no LED in the chain reads.
  */
+static void ws2812_dma_callback(void* param, uint32_t flags) {
+    (void)param;
+    if ((flags & STM32_DMA_ISR_TCIF) && ws2812_frame_pending) {
+        uint32_t* sent = (ws2812_frame_buffer == ws2812_frame_buffers[0]) ? ws2812_frame_buffers[1] : ws2812_frame_buffers[0];
+
+        dmaStreamDisable(WS2812_DMA_STREAM);
+        dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
+        dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+        dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE | STM32_DMA_CR_TCIE);
+        dmaStreamEnable(WS2812_DMA_STREAM);
+
+        ws2812_frame_buffer  = sent;
+        ws2812_frame_pending = false;
+    }
+}
+#endif
+
+/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 
 void ws2812_init(void) {
     // Initialize led frame buffer
     uint32_t i;
-    for (i = 0; i < WS2812_COLOR_BIT_N; i++) ws2812_frame_buffer[i] = WS2812_DUTYCYCLE_0;      // All color bits are zero duty cycle
-    for (i = 0; i < WS2812_RESET_BIT_N; i++) ws2812_frame_buffer[i + WS2812_COLOR_BIT_N] = 0;  // All reset bits are zero
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    for (uint8_t b = 0; b < 2; b++) {
+        for (i = 0; i < WS2812_COLOR_BIT_N; i++) ws2812_frame_buffers[b][i + WS2812_COLOR_BIT_START] = WS2812_DUTYCYCLE_0;  // All color bits are zero duty cycle
+        for (i = 0; i < WS2812_RESET_BIT_N; i++) ws2812_frame_buffers[b][i + WS2812_RESET_BIT_START] = 0;                   // All reset bits are zero
+    }
+#else
+    for (i = 0; i < WS2812_COLOR_BIT_N; i++) ws2812_frame_buffer[i + WS2812_COLOR_BIT_START] = WS2812_DUTYCYCLE_0;  // All color bits are zero duty cycle
+    for (i = 0; i < WS2812_RESET_BIT_N; i++) ws2812_frame_buffer[i + WS2812_RESET_BIT_START] = 0;                   // All reset bits are zero
+#endif
 
     palSetLineMode(RGB_DI_PIN, WS2812_OUTPUT_MODE);
 
@@ -256,11 +342,19 @@ void ws2812_init(void) {
 
     // Configure DMA
     // dmaInit(); // Joe added this
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_callback, NULL);
+    dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1]));  // Ziel ist der An-Zeit im Cap-Comp-Register
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffers[0]);
+    dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+    dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE | STM32_DMA_CR_TCIE);
+#else
     dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, NULL, NULL);
     dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1]));  // Ziel ist der An-Zeit im Cap-Comp-Register
     dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
     dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
-    dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
+    dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
+#endif
     // M2P: Memory 2 Periph; PL: Priority Level
 
 #if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
@@ -280,23 +374,41 @@ void ws2812_init(void) {
 }
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
-    // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-    }
+    // Write color to frame buffer, bit 7 is the first word of each byte
+    uint32_t* frame_buffer = ws2812_frame_buffer;
+    ws2812_encode_byte(&frame_buffer[WS2812_RED_BIT(led_number, 7)], r);
+    ws2812_encode_byte(&frame_buffer[WS2812_GREEN_BIT(led_number, 7)], g);
+    ws2812_encode_byte(&frame_buffer[WS2812_BLUE_BIT(led_number, 7)], b);
 }
 
 // Setleds for standard RGB
 void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
-    static bool s_init = false;
+    static bool     s_init = false;
+    static uint16_t report_timer;
     if (!s_init) {
         ws2812_init();
         s_init = true;
     }
 
+    uint32_t start = ws2812_time_start();
+
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    // Until the frame is marked pending again the DMA callback leaves the buffers alone, so a frame
+    // that has not been picked up yet is simply overwritten
+    ws2812_frame_pending = false;
+#endif
+
     for (uint16_t i = 0; i < leds; i++) {
         ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
     }
+
+#ifdef WS2812_PWM_DOUBLE_BUFFER
+    ws2812_frame_pending = true;
+#endif
+
+    uint32_t encode_time_us = ws2812_time_elapsed_us(start);
+    if (timer_elapsed(report_timer) >= WS2812_ENCODE_REPORT_INTERVAL) {
+        report_timer = timer_read();
+        dprintf("ws2812: %u LEDs encoded in %lu us\n", leds, (unsigned long)encode_time_us);
+    }
 }
@@ -12,6 +12,7 @@ from . import chibios
 from . import clean
 from . import compile
 from . import config
+from . import decode_log
 from . import docs
 from . import doctor
 from . import fileformat
@@ -26,6 +27,7 @@ from . import kle2json
 from . import new
 from . import pyformat
 from . import pytest
+from . import via_benchmark
 
 # Supported version information
 #
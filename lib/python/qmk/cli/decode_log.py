@@ -0,0 +1,35 @@
+"""Decode the deferred debug log records in captured console output.
+"""
+import sys
+
+from milc import cli
+
+import qmk.path
+from qmk.debug_log import DebugLogError, FirmwareStrings, LogDecoder
+
+
+@cli.argument('-e', '--elf', arg_only=True, type=qmk.path.normpath, required=True, help='The ELF file of the firmware that produced the log')
+@cli.argument('filename', arg_only=True, nargs='?', default='-', type=qmk.path.FileType('rb'), help='Captured console output, or - to read from stdin. Default: -')
+@cli.subcommand('Decode the debug log of firmware built with DEFERRED_DEBUG_ENABLE.')
+def decode_log(cli):
+    """Formats the binary log records in the console output of a keyboard, using the format strings from its firmware ELF file.
+
+    Console output that is not a log record is passed through unchanged, so `hid_listen | qmk decode-log -e <file>.elf` can be used to follow a keyboard live.
+    """
+    if not cli.args.elf.exists():
+        cli.log.error('ELF file does not exist: %s', cli.args.elf)
+        return False
+
+    try:
+        decoder = LogDecoder(FirmwareStrings(cli.args.elf.read_bytes()))
+    except DebugLogError as e:
+        cli.log.error('Can not decode logs with %s: %s', cli.args.elf, e)
+        return False
+
+    while True:
+        data = cli.args.filename.read1(4096)
+        if not data:
+            break
+
+        sys.stdout.write(decoder.feed(data))
+        sys.stdout.flush()
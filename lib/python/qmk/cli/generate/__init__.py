@@ -2,7 +2,9 @@ from . import api
 from . import config_h
 from . import dfu_header
 from . import docs
+from . import encoded_songs
 from . import info_json
 from . import layouts
+from . import leader_trie
 from . import rgb_breathe_table
 from . import rules_mk
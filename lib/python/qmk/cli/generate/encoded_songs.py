@@ -0,0 +1,70 @@
+"""Generate a header with encoded songs from the SONG macros.
+"""
+from milc import cli
+
+import qmk.path
+from qmk.constants import QMK_FIRMWARE
+from qmk.songs import SongError, encode_song, read_songs
+
+SONG_LIST = QMK_FIRMWARE / 'quantum' / 'audio' / 'song_list.h'
+
+
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help='Quiet mode, only output error messages')
+@cli.argument('-s', '--song', arg_only=True, action='append', default=[], help='Only encode this song. May be passed multiple times.')
+@cli.argument('filenames', nargs='*', arg_only=True, type=qmk.path.normpath, help='C files with the songs to encode. Default: quantum/audio/song_list.h')
+@cli.subcommand('Generates a header of songs encoded for audio_play_encoded_melody().')
+def generate_encoded_songs(cli):
+    """Encode the songs defined in C files, as song macros or SONG arrays, for PLAY_ENCODED_SONG().
+
+    The song macros of quantum/audio/song_list.h can be used by the songs in the given files.
+    """
+    library = SONG_LIST.read_text()
+    filenames = cli.args.filenames or [SONG_LIST]
+    songs = {}
+
+    for filename in filenames:
+        if not filename.exists():
+            cli.log.error('File does not exist: %s', filename)
+            return False
+
+        try:
+            songs.update(read_songs(filename.read_text(), library if filename != SONG_LIST else ''))
+        except SongError as ex:
+            cli.log.error('Can not read the songs in %s: %s', filename, ex)
+            return False
+
+    for song in cli.args.song:
+        if song not in songs:
+            cli.log.error('Song %s was not found', song)
+            return False
+    names = cli.args.song or list(songs)
+
+    songs_h_lines = ['/* This file was generated by `qmk generate-encoded-songs`. Do not edit or copy.', ' */', '', '#pragma once', '', '// clang-format off']
+    for name in names:
+        try:
+            encoded = encode_song(songs[name])
+        except SongError as ex:
+            cli.log.error('Can not encode %s: %s', name, ex)
+            return False
+
+        songs_h_lines.append('')
+        songs_h_lines.append(f'// {name}: {len(songs[name])} notes in {len(encoded)} bytes')
+        songs_h_lines.append(f'const uint8_t PROGMEM {name.lower()}_encoded[] = {{')
+        for start in range(0, len(encoded), 16):
+            songs_h_lines.append('    ' + ' '.join(f'0x{byte:02X},' for byte in encoded[start:start + 16]))
+        songs_h_lines.append('};')
+    songs_h_lines.append('')
+
+    songs_h = '\n'.join(songs_h_lines)
+
+    if cli.args.output:
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        if cli.args.output.exists():
+            cli.args.output.replace(cli.args.output.parent / (cli.args.output.name + '.bak'))
+        cli.args.output.write_text(songs_h)
+
+        if not cli.args.quiet:
+            cli.log.info('Wrote header to %s.', cli.args.output)
+    else:
+        print(songs_h)
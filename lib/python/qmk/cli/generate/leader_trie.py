@@ -0,0 +1,153 @@
+"""Generate a leader_sequences.h from a JSON list of leader sequences.
+"""
+import json
+import re
+
+from milc import cli
+
+import qmk.path
+
+NO_ACTION = 0xFFFF
+MAX_WORD = 0xFFFF
+
+
+def _new_node():
+    return {'action': None, 'children': {}}
+
+
+def build_trie(sequences):
+    """Builds a nested trie from a list of `{"keys": [...], "action": "NAME"}` dictionaries.
+
+    Returns the root node and the list of action names in index order.
+    """
+    root = _new_node()
+    actions = []
+    identifiers = {}
+
+    for sequence in sequences:
+        keys = sequence['keys']
+        action = sequence['action']
+
+        if not keys:
+            raise ValueError(f'Sequence for action {action} has no keys')
+        if not re.match(r'^[A-Za-z_][A-Za-z0-9_]*$', action):
+            raise ValueError(f'Action name {action} is not a valid C identifier')
+        if action in actions:
+            raise ValueError(f'Action {action} is defined more than once')
+        if action.upper() in identifiers:
+            raise ValueError(f'Actions {identifiers[action.upper()]} and {action} would both be LEADER_{action.upper()}')
+        if len(actions) == NO_ACTION:
+            raise ValueError(f'Too many actions, at most {NO_ACTION} are supported')
+        for key in keys:
+            if re.match(r'^(0x[0-9A-Fa-f]+|[0-9]+)$', key) and int(key, 0) > MAX_WORD:
+                raise ValueError(f'Keycode {key} of action {action} does not fit in 16 bits')
+
+        node = root
+        for key in keys:
+            node = node['children'].setdefault(key, _new_node())
+
+        if node['action'] is not None:
+            raise ValueError(f'Sequence {" ".join(keys)} is used by both {actions[node["action"]]} and {action}')
+
+        node['action'] = len(actions)
+        actions.append(action)
+        identifiers[action.upper()] = action
+
+    return root, actions
+
+
+def serialize_trie(root, actions):
+    """Flattens the trie into the word layout read by quantum/leader/leader_trie.c.
+
+    Every node is `action, child_count, (keycode, child_offset) * child_count`. Returns a list of (C expression, comment) tuples.
+
+    Raises ValueError if the trie is too large for its offsets to fit in a word.
+    """
+    nodes = []
+    offsets = {}
+
+    # Breadth first, so that siblings end up close together in flash
+    queue = [(root, [])]
+    offset = 0
+    while queue:
+        node, path = queue.pop(0)
+        if offset > MAX_WORD:
+            raise ValueError(f'The trie is too large, {" ".join(path)} is at word {offset} but offsets must fit in 16 bits')
+        offsets[id(node)] = offset
+        nodes.append((node, path))
+        offset += 2 + 2 * len(node['children'])
+        for key, child in node['children'].items():
+            queue.append((child, path + [key]))
+
+    words = []
+    for node, path in nodes:
+        action = f'0x{NO_ACTION:04X}' if node['action'] is None else f'LEADER_{actions[node["action"]].upper()}'
+        words.append((action, ' '.join(path) or 'root'))
+        words.append((str(len(node['children'])), None))
+        for key, child in node['children'].items():
+            words.append((key, None))
+            words.append((str(offsets[id(child)]), None))
+
+    return words
+
+
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help='Quiet mode, only output error messages')
+@cli.argument('filename', type=qmk.path.FileType('r'), arg_only=True, help='JSON file with the leader sequences')
+@cli.subcommand('Generates a leader key sequence trie header.')
+def generate_leader_trie(cli):
+    """Generate a leader_sequences.h containing the PROGMEM trie used when LEADER_TRIE_ENABLE is set.
+
+    The trie is defined, not only declared, so the header must be included from a single file, normally keymap.c.
+    """
+    if cli.args.output and cli.args.output.name == 'leader_trie.h':
+        # The keymap directory is searched first, so this would hide quantum/leader/leader_trie.h
+        cli.log.error('The output can not be named leader_trie.h, use leader_sequences.h instead.')
+        return False
+
+    try:
+        leader_json = json.load(cli.args.filename)
+        root, actions = build_trie(leader_json['sequences'])
+        words = serialize_trie(root, actions)
+
+    except json.decoder.JSONDecodeError as ex:
+        cli.log.error('The JSON input does not appear to be valid.')
+        cli.log.error(ex)
+        return False
+
+    except (KeyError, ValueError) as ex:
+        cli.log.error('Invalid leader sequence: %s', ex)
+        return False
+
+    trie_h_lines = ['/* This file was generated by `qmk generate-leader-trie`. Do not edit or copy.', ' *', ' * It defines leader_trie_data, so include it from keymap.c only.', ' */', '', '#pragma once', '', '// clang-format off', '']
+    trie_h_lines.append('enum leader_trie_actions {')
+    for action in actions:
+        trie_h_lines.append(f'    LEADER_{action.upper()},')
+    trie_h_lines.append('};')
+    trie_h_lines.append('')
+    trie_h_lines.append('const uint16_t PROGMEM leader_trie_data[] = {')
+    line = []
+    for word, comment in words:
+        if comment is not None:
+            if line:
+                trie_h_lines.append('    ' + ' '.join(line))
+            trie_h_lines.append(f'    // {comment}')
+            line = []
+        line.append(f'{word},')
+    if line:
+        trie_h_lines.append('    ' + ' '.join(line))
+    trie_h_lines.append('};')
+    trie_h_lines.append('')
+
+    trie_h = '\n'.join(trie_h_lines)
+
+    if cli.args.output:
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        if cli.args.output.exists():
+            cli.args.output.replace(cli.args.output.parent / (cli.args.output.name + '.bak'))
+        cli.args.output.write_text(trie_h)
+
+        if not cli.args.quiet:
+            cli.log.info('Wrote header to %s.', cli.args.output)
+    else:
+        print(trie_h)
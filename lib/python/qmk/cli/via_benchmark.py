@@ -0,0 +1,48 @@
+"""Measure VIA bulk transfer throughput against a simulated keyboard.
+"""
+import random
+
+from milc import cli
+
+from qmk.via_bulk import REGION_CUSTOM_CONFIG, REGION_KEYMAP, REGION_MACROS, WINDOW_PACKETS, benchmark
+
+REGION_NAMES = {
+    REGION_KEYMAP: 'keymap',
+    REGION_MACROS: 'macros',
+    REGION_CUSTOM_CONFIG: 'custom config',
+}
+
+
+@cli.argument('--layers', arg_only=True, type=int, default=4, help='Number of dynamic keymap layers. Default: 4')
+@cli.argument('--rows', arg_only=True, type=int, default=6, help='Number of matrix rows. Default: 6')
+@cli.argument('--cols', arg_only=True, type=int, default=17, help='Number of matrix columns. Default: 17')
+@cli.argument('--macro-size', arg_only=True, type=int, default=1024, help='Size of the macro buffer in bytes. Default: 1024')
+@cli.argument('--custom-config-size', arg_only=True, type=int, default=32, help='Size of the custom config area in bytes. Default: 32')
+@cli.argument('--poll-interval', arg_only=True, type=float, default=1.0, help='Raw HID endpoint polling interval in milliseconds. Default: 1.0')
+@cli.argument('--round-trip', arg_only=True, type=float, default=1.0, help='Extra milliseconds the host waits for each answer. Default: 1.0')
+@cli.argument('--window', arg_only=True, type=int, default=WINDOW_PACKETS, help=f'Packets per bulk window (VIA_BULK_WINDOW_PACKETS). Default: {WINDOW_PACKETS}')
+@cli.subcommand('Measure VIA bulk transfer throughput against a simulated keyboard.', hidden=False if cli.config.user.developer else True)
+def via_benchmark(cli):
+    """Transfers random keyboard memory with the legacy 28 byte commands and the bulk commands, and compares the time taken.
+    """
+    rng = random.Random(0)
+    regions = {
+        REGION_KEYMAP: bytearray(rng.randrange(256) for _ in range(cli.args.layers * cli.args.rows * cli.args.cols * 2)),
+        REGION_MACROS: bytearray(rng.randrange(256) for _ in range(cli.args.macro_size)),
+    }
+    if cli.args.custom_config_size:
+        regions[REGION_CUSTOM_CONFIG] = bytearray(rng.randrange(256) for _ in range(cli.args.custom_config_size))
+
+    results = benchmark(regions, cli.args.poll_interval, cli.args.round_trip, cli.args.window)
+
+    legacy_ms = {}
+    for result in results:
+        key = (result['region'], result['direction'])
+        throughput = result['bytes'] / result['ms'] if result['ms'] else 0
+        speedup = ''
+        if result['protocol'] == 'legacy':
+            legacy_ms[key] = result['ms']
+        elif key in legacy_ms:
+            speedup = f' ({legacy_ms[key] / result["ms"]:.1f}x faster)'
+
+        cli.echo(f"{REGION_NAMES[result['region']]:<14} {result['protocol']:<6} {result['direction']:<5} {result['bytes']:>6} bytes {result['reports']:>5} reports {result['ms']:>8.1f} ms {throughput:>6.1f} kB/s{speedup}")
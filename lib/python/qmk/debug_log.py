@@ -0,0 +1,223 @@
+"""Decoding of the deferred debug log records sent by firmware built with DEFERRED_DEBUG_ENABLE.
+
+See tmk_core/common/debug_log.h for the record layout.
+"""
+import codecs
+import re
+import struct
+
+RECORD_START = 0x1E
+
+ELF_MAGIC = b'\x7fELF'
+ELFCLASS32 = 1
+ELFDATA2LSB = 1
+EM_ARM = 40
+EM_AVR = 83
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+# sizeof(int) and sizeof(void *) on each architecture QMK builds for
+TARGET_SIZES = {
+    EM_ARM: (4, 4),
+    EM_AVR: (2, 2),
+}
+
+CONVERSION = re.compile(rb'%([-+ #0]*)(\*|\d*)(?:\.(\*|\d*))?(hh|h|l)?(.)', re.DOTALL)
+
+
+class DebugLogError(Exception):
+    """Raised when the firmware file can not be used for decoding.
+    """
+
+
+class FirmwareStrings:
+    """Looks up the format strings in a firmware ELF file by their address.
+    """
+    def __init__(self, elf):
+        if elf[:4] != ELF_MAGIC:
+            raise DebugLogError('Not an ELF file')
+        if elf[4] != ELFCLASS32 or elf[5] != ELFDATA2LSB:
+            raise DebugLogError('Only 32 bit little endian ELF files are supported')
+
+        machine, = struct.unpack_from('<H', elf, 18)
+        if machine not in TARGET_SIZES:
+            raise DebugLogError(f'Unsupported machine type {machine}')
+        self.int_size, self.pointer_size = TARGET_SIZES[machine]
+
+        section_offset, = struct.unpack_from('<I', elf, 32)
+        section_size, section_count = struct.unpack_from('<HH', elf, 46)
+
+        # Everything loaded into the flash or RAM image, as (address, contents)
+        self.sections = []
+        for index in range(section_count):
+            _, section_type, flags, address, offset, size = struct.unpack_from('<IIIIII', elf, section_offset + index*section_size)
+            if flags & SHF_ALLOC and section_type != SHT_NOBITS and size:
+                self.sections.append((address, elf[offset:offset + size]))
+
+        self.cache = {}
+
+    def string_at(self, address):
+        """Returns the NUL terminated string at `address` as bytes, or None if no section holds it.
+        """
+        if address not in self.cache:
+            self.cache[address] = None
+            for start, contents in self.sections:
+                if start <= address < start + len(contents):
+                    end = contents.find(b'\0', address - start)
+                    self.cache[address] = contents[address - start:end if end >= 0 else len(contents)]
+                    break
+
+        return self.cache[address]
+
+
+def cobs_decode(data):
+    """Returns the COBS encoded `data` decoded, or None if it is malformed.
+    """
+    decoded = bytearray()
+    index = 0
+
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            return None
+        decoded += data[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(data):
+            decoded.append(0)
+
+    return bytes(decoded)
+
+
+class _Arguments:
+    """Reads the raw argument values of one record in order.
+    """
+    def __init__(self, payload):
+        self.payload = payload
+        self.index = 0
+
+    def integer(self, size, signed):
+        if self.index + size > len(self.payload):
+            raise IndexError
+        value = int.from_bytes(self.payload[self.index:self.index + size], 'little', signed=signed)
+        self.index += size
+        return value
+
+    def string(self):
+        end = self.payload.find(b'\0', self.index)
+        if end < 0:
+            raise IndexError
+        value = self.payload[self.index:end]
+        self.index = end + 1
+        return value.decode('utf-8', 'replace')
+
+
+def format_message(fmt, payload, int_size=4, pointer_size=4):
+    """Formats a message the way the firmware's printf would have, from its format string and raw arguments.
+    """
+    arguments = _Arguments(payload)
+    message = []
+    position = 0
+
+    for match in CONVERSION.finditer(fmt):
+        message.append(fmt[position:match.start()].decode('utf-8', 'replace'))
+        position = match.end()
+        flags, width, precision, length, conversion = match.groups()
+        flags = flags.decode()
+        conversion = conversion.decode('latin-1')
+
+        try:
+            if conversion == '%':
+                message.append('%')
+                continue
+
+            if width == b'*':
+                width = arguments.integer(int_size, True)
+                if width < 0:
+                    flags += '-'
+                    width = -width
+            width = int(width) if width else 0
+
+            size = 4 if length == b'l' else int_size
+            if conversion in 'di':
+                value = arguments.integer(size, True)
+            elif conversion in 'uxXob':
+                value = arguments.integer(size, False)
+            elif conversion == 'c':
+                value = chr(arguments.integer(1, False))
+            elif conversion in 'sS':
+                value = arguments.string()
+                if precision and precision != b'*':
+                    value = value[:int(precision)]
+            elif conversion == 'p':
+                value = f'0x{arguments.integer(pointer_size, False):0{pointer_size * 2}x}'
+            else:
+                message.append(match.group(0).decode('utf-8', 'replace'))
+                continue
+        except IndexError:
+            message.append('<missing>')
+            break
+
+        if isinstance(value, str):
+            message.append(value.ljust(width) if '-' in flags else value.rjust(width))
+            continue
+
+        spec = '<' if '-' in flags else ''
+        spec += '+' if '+' in flags else ' ' if ' ' in flags else ''
+        spec += '#' if '#' in flags else ''
+        spec += '0' if '0' in flags and '-' not in flags else ''
+        spec += str(width) if width else ''
+        spec += {'i': 'd', 'u': 'd'}.get(conversion, conversion)
+        message.append(format(value, spec))
+    else:
+        message.append(fmt[position:].decode('utf-8', 'replace'))
+
+    return ''.join(message)
+
+
+class LogDecoder:
+    """Turns the console output of a keyboard into text, formatting the deferred log records it contains.
+    """
+    def __init__(self, strings):
+        self.strings = strings
+        self.text = codecs.getincrementaldecoder('utf-8')('replace')
+        self.record = None
+        self.length = None
+
+    def decode_record(self, data):
+        payload = cobs_decode(data)
+        if payload is None or len(payload) < self.strings.pointer_size:
+            return '<corrupt log record>\n'
+
+        address = int.from_bytes(payload[:self.strings.pointer_size], 'little')
+        fmt = self.strings.string_at(address)
+        if fmt is None:
+            return f'<unknown log format at 0x{address:x}>\n'
+
+        return format_message(fmt, payload[self.strings.pointer_size:], self.strings.int_size, self.strings.pointer_size)
+
+    def feed(self, data):
+        """Returns the text for the next chunk of console output.
+        """
+        output = []
+        text = bytearray()
+
+        for byte in data:
+            if self.record is not None:
+                if self.length is None:
+                    self.length = byte
+                    continue
+                self.record.append(byte)
+                if len(self.record) == self.length:
+                    output.append(self.decode_record(bytes(self.record)))
+                    self.record = None
+                    self.length = None
+            elif byte == RECORD_START:
+                output.append(self.text.decode(bytes(text)))
+                text = bytearray()
+                self.record = bytearray()
+            elif byte != 0:
+                # Zero bytes are padding in console reports
+                text.append(byte)
+
+        output.append(self.text.decode(bytes(text)))
+        return ''.join(output)
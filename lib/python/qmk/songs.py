@@ -0,0 +1,176 @@
+"""Reading the SONG macros of quantum/audio/song_list.h, and encoding them for audio_play_encoded_melody().
+
+See quantum/audio/encoded_song.h for the encoded format.
+"""
+import re
+
+REST = 0
+NOTE_NAMES = ['C', 'CS', 'D', 'DS', 'E', 'F', 'FS', 'G', 'GS', 'A', 'AS', 'B']
+FLAT_NAMES = {'DF': 'CS', 'EF': 'DS', 'GF': 'FS', 'AF': 'GS', 'BF': 'AS'}
+OCTAVES = 9
+HAS_DURATION = 0x80
+
+# The note type macros of musical_notes.h, and their durations
+NOTE_DURATIONS = {
+    'BREVE_NOTE': 128,
+    'WHOLE_NOTE': 64,
+    'HALF_NOTE': 32,
+    'QUARTER_NOTE': 16,
+    'EIGHTH_NOTE': 8,
+    'SIXTEENTH_NOTE': 4,
+    'THIRTYSECOND_NOTE': 2,
+    'BREVE_DOT_NOTE': 128 + 64,
+    'WHOLE_DOT_NOTE': 64 + 32,
+    'HALF_DOT_NOTE': 32 + 16,
+    'QUARTER_DOT_NOTE': 16 + 8,
+    'EIGHTH_DOT_NOTE': 8 + 4,
+    'SIXTEENTH_DOT_NOTE': 4 + 2,
+    'THIRTYSECOND_DOT_NOTE': 2 + 1,
+    'B__NOTE': 128,
+    'W__NOTE': 64,
+    'H__NOTE': 32,
+    'Q__NOTE': 16,
+    'E__NOTE': 8,
+    'S__NOTE': 4,
+    'T__NOTE': 2,
+    'BD_NOTE': 128 + 64,
+    'WD_NOTE': 64 + 32,
+    'HD_NOTE': 32 + 16,
+    'QD_NOTE': 16 + 8,
+    'ED_NOTE': 8 + 4,
+    'SD_NOTE': 4 + 2,
+    'TD_NOTE': 2 + 1,
+}
+VARIABLE_DURATION = ('MUSICAL_NOTE', 'M__NOTE')
+
+DEFINE = re.compile(r'^[ \t]*#[ \t]*define[ \t]+([A-Za-z_]\w*)(?![\w(])(.*)$', re.MULTILINE)
+SONG_ARRAY = re.compile(r'float\s+([A-Za-z_]\w*)\s*\[\s*\]\s*\[\s*2\s*\]\s*=\s*SONG\s*\((.*?)\)\s*;', re.DOTALL)
+COMMENT = re.compile(r'/\*.*?\*/|//[^\n]*', re.DOTALL)
+DURATION_EXPRESSION = re.compile(r'^[\d\s+*/()-]+$')
+
+
+class SongError(Exception):
+    """Raised when a song can not be read or encoded.
+    """
+
+
+def note_index(name):
+    """Returns the encoded note for a musical_notes.h note name like `_CS4`, `_BF3` or `_REST`.
+    """
+    match = re.match(r'^_([A-G][SF]?)(\d)$', name)
+    if name == '_REST':
+        return REST
+    if not match:
+        raise SongError(f'Unknown note {name}')
+
+    pitch, octave = FLAT_NAMES.get(match.group(1), match.group(1)), int(match.group(2))
+    if pitch not in NOTE_NAMES or octave >= OCTAVES:
+        raise SongError(f'Unknown note {name}')
+
+    return 1 + octave * len(NOTE_NAMES) + NOTE_NAMES.index(pitch)
+
+
+def _split_arguments(text):
+    """Splits a comma separated list, ignoring the commas inside parentheses.
+    """
+    items = []
+    depth = 0
+    current = ''
+
+    for character in text:
+        if character == ',' and depth == 0:
+            items.append(current.strip())
+            current = ''
+            continue
+        depth += {'(': 1, ')': -1}.get(character, 0)
+        current += character
+
+    items.append(current.strip())
+    return [item for item in items if item]
+
+
+def _strip(source):
+    return COMMENT.sub('', source.replace('\\\n', ' '))
+
+
+def read_songs(source, library=''):
+    """Returns the songs in the source of a C file, as a dictionary of name to (note, duration) lists.
+
+    Both song macros (`#define ODE_TO_JOY Q__NOTE(_E4), ...`) and SONG arrays (`float my_song[][2] = SONG(...);`) are read.
+    The song macros in `library`, usually quantum/audio/song_list.h, can be used by the songs but are not returned themselves.
+    """
+    source = _strip(source)
+    macros = {name: body.strip() for name, body in DEFINE.findall(_strip(library))}
+    own_macros = {name: body.strip() for name, body in DEFINE.findall(source)}
+    macros.update(own_macros)
+    songs = {}
+
+    def expand(body, seen):
+        notes = []
+        for item in _split_arguments(body):
+            call = re.match(r'^(\w+)\s*\((.*)\)$', item, re.DOTALL)
+            if call and call.group(1) in NOTE_DURATIONS:
+                notes.append((note_index(call.group(2).strip()), NOTE_DURATIONS[call.group(1)]))
+            elif call and call.group(1) in VARIABLE_DURATION:
+                arguments = _split_arguments(call.group(2))
+                if len(arguments) != 2 or not DURATION_EXPRESSION.match(arguments[1]):
+                    raise SongError(f'Can not read the duration of {item}')
+                notes.append((note_index(arguments[0]), int(eval(arguments[1], {'__builtins__': {}}))))
+            elif call and call.group(1) == 'SONG':
+                notes += expand(call.group(2), seen)
+            elif item in macros and item not in seen:
+                notes += expand(macros[item], seen | {item})
+            else:
+                raise SongError(f'Unknown note or song {item}')
+        return notes
+
+    for name, body in own_macros.items():
+        try:
+            notes = expand(body, {name})
+        except SongError:
+            # Not a song macro
+            continue
+        if notes:
+            songs[name] = notes
+
+    for name, body in SONG_ARRAY.findall(source):
+        songs[name] = expand(body, set())
+
+    return songs
+
+
+def encode_song(notes):
+    """Returns the bytes of a song in the encoded format, from a list of (note, duration) tuples.
+    """
+    encoded = bytearray()
+    previous_duration = None
+
+    for note, duration in notes:
+        if not 1 <= duration <= 255:
+            raise SongError(f'Duration {duration} does not fit the encoded format, which allows 1 to 255')
+
+        if duration == previous_duration:
+            encoded.append(note)
+        else:
+            encoded += bytes([note | HAS_DURATION, duration])
+            previous_duration = duration
+
+    return bytes(encoded)
+
+
+def decode_song(encoded):
+    """Returns the (note, duration) tuples of an encoded song, the way quantum/audio/encoded_song.c reads them.
+    """
+    notes = []
+    duration = 0
+    index = 0
+
+    while index < len(encoded):
+        value = encoded[index]
+        index += 1
+        if value & HAS_DURATION and index < len(encoded):
+            duration = encoded[index]
+            index += 1
+        notes.append((value & ~HAS_DURATION, duration))
+
+    return notes
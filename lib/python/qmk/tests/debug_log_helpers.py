@@ -0,0 +1,29 @@
+"""Firmware images and console records for testing the deferred debug log decoder.
+"""
+import struct
+
+from qmk.debug_log import EM_ARM, RECORD_START
+
+RODATA_ADDRESS = 0x08001000
+
+
+def make_elf(contents, address=RODATA_ADDRESS, machine=EM_ARM):
+    """Returns a minimal ELF file with a single allocated section holding `contents` at `address`.
+    """
+    section_offset = 52 + len(contents)
+    header = b'\x7fELF' + bytes([1, 1, 1]) + bytes(9)
+    header += struct.pack('<HHIIIIIHHHHHH', 2, machine, 1, 0, 0, section_offset, 0, 52, 0, 0, 40, 2, 0)
+    sections = bytes(40) + struct.pack('<IIIIIIIIII', 0, 1, 0x2, address, 52, len(contents), 0, 0, 1, 0)
+
+    return header + contents + sections
+
+
+def encode_record(address, payload, pointer_size=4):
+    """Encodes a record the way tmk_core/common/debug_log.c does.
+    """
+    data = address.to_bytes(pointer_size, 'little') + payload
+    encoded = bytearray()
+    for block in data.split(b'\0'):
+        encoded += bytes([len(block) + 1]) + block
+
+    return bytes([RECORD_START, len(encoded)]) + encoded
@@ -2,7 +2,11 @@ import platform
 
 from subprocess import STDOUT, PIPE
 
+import pytest
+
+from qmk.cli.generate.leader_trie import build_trie, serialize_trie
 from qmk.commands import run
+from qmk.tests.debug_log_helpers import RODATA_ADDRESS, encode_record, make_elf
 
 is_windows = 'windows' in platform.platform().lower()
 
@@ -232,6 +236,59 @@ def test_generate_rgb_breathe_table():
     assert 'Breathing max:    127' in result.stdout
 
 
+def test_generate_leader_trie():
+    result = check_subcommand('generate-leader-trie', 'lib/python/qmk/tests/leader_sequences.json')
+    check_returncode(result)
+    assert 'LEADER_HOME_ROW,' in result.stdout
+    assert '// KC_A KC_S KC_D KC_F KC_G KC_H' in result.stdout
+    assert 'const uint16_t PROGMEM leader_trie_data[] = {' in result.stdout
+
+
+def test_generate_leader_trie_not_named_leader_trie_h():
+    result = check_subcommand('generate-leader-trie', '-o', '.build/leader_trie.h', 'lib/python/qmk/tests/leader_sequences.json')
+    check_returncode(result, [1])
+    assert 'leader_sequences.h' in result.stdout
+
+
+def test_generate_leader_trie_identifier_collision():
+    result = check_subcommand('generate-leader-trie', 'lib/python/qmk/tests/leader_sequences_collision.json')
+    check_returncode(result, [1])
+    assert 'Actions copy and COPY would both be LEADER_COPY' in result.stdout
+
+
+def test_generate_leader_trie_offset_overflow():
+    sequences = [{'keys': [str(key)], 'action': f'action_{key}'} for key in range(20000)]
+    root, actions = build_trie(sequences)
+    with pytest.raises(ValueError, match='offsets must fit in 16 bits'):
+        serialize_trie(root, actions)
+
+
+def test_generate_encoded_songs():
+    result = check_subcommand('generate-encoded-songs', '-s', 'ODE_TO_JOY')
+    check_returncode(result)
+    assert '// ODE_TO_JOY: 15 notes in 19 bytes' in result.stdout
+    assert 'const uint8_t PROGMEM ode_to_joy_encoded[] = {' in result.stdout
+    assert 'startup_sound_encoded' not in result.stdout
+
+
+def test_via_benchmark():
+    result = check_subcommand('via-benchmark', '--layers', '2', '--macro-size', '256')
+    check_returncode(result)
+    assert 'keymap         bulk   read' in result.stdout
+    assert 'faster' in result.stdout
+
+
+def test_decode_log(tmp_path):
+    elf = tmp_path / 'firmware.elf'
+    capture = tmp_path / 'capture.bin'
+    elf.write_bytes(make_elf(b'scan rate: %lu\n\0'))
+    capture.write_bytes(b'hello\n' + encode_record(RODATA_ADDRESS, (1234).to_bytes(4, 'little')))
+
+    result = check_subcommand('decode-log', '-e', str(elf), str(capture))
+    check_returncode(result)
+    assert result.stdout == 'hello\nscan rate: 1234\n'
+
+
 def test_generate_config_h():
     result = check_subcommand('generate-config-h', '-kb', 'handwired/pytest/basic')
     check_returncode(result)
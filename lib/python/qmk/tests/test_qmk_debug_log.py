@@ -0,0 +1,47 @@
+import struct
+
+import pytest
+
+from qmk.debug_log import EM_AVR, DebugLogError, FirmwareStrings, LogDecoder, cobs_decode, format_message
+from qmk.tests.debug_log_helpers import RODATA_ADDRESS, encode_record, make_elf
+
+
+def test_cobs_decode():
+    assert cobs_decode(b'\x03ab\x01\x02c') == b'ab\0\0c'
+    assert cobs_decode(b'\x05ab') is None
+
+
+def test_format_message():
+    payload = struct.pack('<HhH', 3, -5, 0xAB) + b'ab\0' + struct.pack('<H', 5) + b'z' + struct.pack('<I', 0xDEADBEEF)
+    message = format_message(b'row %u col %d: %02X %-4s| %08b %c %% %08lX\n', payload, int_size=2, pointer_size=2)
+    assert message == 'row 3 col -5: AB ab  | 00000101 z % DEADBEEF\n'
+
+
+def test_format_message_missing_arguments():
+    assert format_message(b'%u and %u\n', struct.pack('<I', 1)) == '1 and <missing>'
+
+
+def test_firmware_strings():
+    strings = FirmwareStrings(make_elf(b'first\0second %u\0', machine=EM_AVR))
+    assert (strings.int_size, strings.pointer_size) == (2, 2)
+    assert strings.string_at(RODATA_ADDRESS + 6) == b'second %u'
+    assert strings.string_at(RODATA_ADDRESS - 1) is None
+
+
+def test_firmware_strings_not_elf():
+    with pytest.raises(DebugLogError):
+        FirmwareStrings(b'not an elf file')
+
+
+def test_log_decoder():
+    decoder = LogDecoder(FirmwareStrings(make_elf(b'\0matrix row %u: %04X\n\0')))
+    stream = b'plain text\n\0\0' + encode_record(RODATA_ADDRESS + 1, struct.pack('<II', 2, 0x0130)) + encode_record(RODATA_ADDRESS + 100, b'') + b'more'
+
+    # Feed a byte at a time, as records can be split across console reports
+    output = ''.join(decoder.feed(stream[i:i + 1]) for i in range(len(stream)))
+    assert output == f'plain text\nmatrix row 2: 0130\n<unknown log format at 0x{RODATA_ADDRESS + 100:x}>\nmore'
+
+
+def test_format_message_plain_string():
+    # dprint() sends its string as the argument of a "%s" record, so a % in it stays as it is
+    assert format_message(b'%s', b'50% done\0') == '50% done'
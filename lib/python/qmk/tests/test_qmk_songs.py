@@ -0,0 +1,49 @@
+import pytest
+
+from qmk.songs import HAS_DURATION, REST, SongError, decode_song, encode_song, note_index, read_songs
+
+
+def test_note_index():
+    assert note_index('_REST') == REST
+    assert note_index('_C0') == 1
+    assert note_index('_A4') == 58
+    assert note_index('_BF3') == note_index('_AS3')
+    assert note_index('_B8') == 108
+
+    for name in ('_C9', '_H4', '_FF4', 'A4'):
+        with pytest.raises(SongError):
+            note_index(name)
+
+
+def test_read_songs():
+    source = '''
+        #define TEMPO 120
+        #define FANFARE Q__NOTE(_C4), QD_NOTE(_E4), /* a comment */ \\
+            M__NOTE(_G4, 16 + 4), S__NOTE(_REST),
+        #define FANFARE_TWICE FANFARE FANFARE
+        #define TWICE FANFARE, FANFARE
+    '''
+    songs = read_songs(source)
+    assert list(songs) == ['FANFARE', 'TWICE']
+    assert songs['FANFARE'] == [(49, 16), (53, 24), (56, 20), (REST, 4)]
+    assert songs['TWICE'] == songs['FANFARE'] * 2
+
+
+def test_read_song_arrays():
+    library = '#define STARTUP_SOUND E__NOTE(_E6), E__NOTE(_A6), ED_NOTE(_E7),\n'
+    songs = read_songs('float my_song[][2] = SONG(STARTUP_SOUND, W__NOTE(_C5));', library)
+    assert songs == {'my_song': [(77, 8), (82, 8), (89, 12), (61, 64)]}
+
+    with pytest.raises(SongError):
+        read_songs('float other[][2] = SONG(NOT_A_SONG);', library)
+
+
+def test_encode_song():
+    notes = [(49, 16), (53, 16), (REST, 8), (56, 8), (56, 255)]
+    encoded = encode_song(notes)
+    assert encoded == bytes([49 | HAS_DURATION, 16, 53, REST | HAS_DURATION, 8, 56, 56 | HAS_DURATION, 255])
+    assert decode_song(encoded) == notes
+
+    for duration in (0, 256):
+        with pytest.raises(SongError):
+            encode_song([(49, duration)])
@@ -0,0 +1,56 @@
+import pytest
+
+from qmk.via_bulk import REGION_CUSTOM_CONFIG, REGION_KEYMAP, REGION_MACROS, BulkClient, BulkTransferError, LegacyClient, SimulatedKeyboard, benchmark, crc16
+
+REGIONS = {
+    REGION_KEYMAP: bytearray(i * 7 & 0xFF for i in range(4 * 6 * 17 * 2)),
+    REGION_MACROS: bytearray(i * 13 & 0xFF for i in range(1024)),
+    REGION_CUSTOM_CONFIG: bytearray(range(32)),
+}
+
+
+def test_crc16():
+    assert crc16(b'123456789') == 0x29B1
+
+
+def test_bulk_read():
+    device = SimulatedKeyboard(REGIONS)
+    assert BulkClient(device).read(REGION_KEYMAP, 10, 500) == REGIONS[REGION_KEYMAP][10:510]
+
+
+def test_bulk_write():
+    device = SimulatedKeyboard(REGIONS)
+    BulkClient(device).write(REGION_MACROS, 100, bytes(range(200)))
+    assert device.regions[REGION_MACROS][100:300] == bytes(range(200))
+    assert device.regions[REGION_MACROS][:100] == REGIONS[REGION_MACROS][:100]
+
+
+def test_bulk_write_retries_lost_packet():
+    device = SimulatedKeyboard(REGIONS, drop_packet=3)
+    BulkClient(device).write(REGION_KEYMAP, 0, bytes(200))
+    assert device.regions[REGION_KEYMAP][:200] == bytes(200)
+
+
+def test_bulk_smaller_window():
+    device = SimulatedKeyboard(REGIONS, window_packets=4)
+    client = BulkClient(device)
+    assert client.read(REGION_MACROS, 0, 1024) == REGIONS[REGION_MACROS]
+    assert client.window == 4 * 30
+
+
+def test_bulk_invalid_range():
+    with pytest.raises(BulkTransferError):
+        BulkClient(SimulatedKeyboard(REGIONS)).read(REGION_CUSTOM_CONFIG, 16, 32)
+
+
+def test_legacy_read():
+    device = SimulatedKeyboard(REGIONS)
+    assert LegacyClient(device).read(REGION_MACROS, 0, 100) == REGIONS[REGION_MACROS][:100]
+
+
+def test_benchmark_bulk_is_faster():
+    results = {(result['region'], result['protocol'], result['direction']): result for result in benchmark(REGIONS)}
+
+    for region in (REGION_KEYMAP, REGION_MACROS):
+        for direction in ('read', 'write'):
+            assert results[region, 'bulk', direction]['ms'] < results[region, 'legacy', direction]['ms']
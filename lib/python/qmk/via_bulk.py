@@ -0,0 +1,326 @@
+"""Host side of the VIA bulk transfer commands, and a simulated keyboard to measure them against.
+
+See the id_bulk_* definitions in quantum/via.h for the packet layouts.
+"""
+PACKET_SIZE = 32
+LEGACY_DATA_SIZE = 28
+BULK_DATA_SIZE = PACKET_SIZE - 2
+WINDOW_PACKETS = 16
+
+ID_DYNAMIC_KEYMAP_MACRO_GET_BUFFER = 0x0E
+ID_DYNAMIC_KEYMAP_MACRO_SET_BUFFER = 0x0F
+ID_DYNAMIC_KEYMAP_GET_BUFFER = 0x12
+ID_DYNAMIC_KEYMAP_SET_BUFFER = 0x13
+ID_BULK_READ = 0x14
+ID_BULK_WRITE = 0x15
+ID_BULK_DATA = 0x16
+ID_UNHANDLED = 0xFF
+
+REGION_KEYMAP = 0x01
+REGION_MACROS = 0x02
+REGION_CUSTOM_CONFIG = 0x03
+
+STATUS_OK = 0x00
+STATUS_INVALID_RANGE = 0x01
+STATUS_SEQUENCE_ERROR = 0x02
+STATUS_NO_TRANSFER = 0x03
+
+LEGACY_COMMANDS = {
+    REGION_KEYMAP: (ID_DYNAMIC_KEYMAP_GET_BUFFER, ID_DYNAMIC_KEYMAP_SET_BUFFER),
+    REGION_MACROS: (ID_DYNAMIC_KEYMAP_MACRO_GET_BUFFER, ID_DYNAMIC_KEYMAP_MACRO_SET_BUFFER),
+}
+
+
+class BulkTransferError(Exception):
+    """Raised when a bulk transfer fails after all retries.
+    """
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as computed by the keyboard.
+    """
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+        crc &= 0xFFFF
+
+    return crc
+
+
+def encode_request(command, region, offset, size):
+    """Returns a bulk read or write request packet.
+    """
+    packet = bytearray(PACKET_SIZE)
+    packet[0:6] = [command, region, offset >> 8, offset & 0xFF, size >> 8, size & 0xFF]
+
+    return packet
+
+
+def decode_ack(packet):
+    """Returns the fields of a bulk acknowledgement packet as a dictionary.
+    """
+    return {
+        'command': packet[0],
+        'region': packet[1],
+        'offset': (packet[2] << 8) | packet[3],
+        'size': (packet[4] << 8) | packet[5],
+        'status': packet[6],
+        'crc': (packet[7] << 8) | packet[8],
+        'window': (packet[9] << 8) | packet[10],
+    }
+
+
+class SimulatedKeyboard:
+    """Answers raw HID reports the way quantum/via.c does, and keeps count of the USB frames used.
+
+    Every report in either direction costs one polling interval of the interrupt endpoints, and every
+    time the host has to wait for an answer before it can carry on costs another `round_trip` milliseconds
+    (the keyboard's main loop picking up the report, and the host OS handing the answer back).
+    """
+    def __init__(self, regions, poll_interval=1.0, round_trip=1.0, window_packets=WINDOW_PACKETS, drop_packet=None):
+        self.regions = {region: bytearray(data) for region, data in regions.items()}
+        self.poll_interval = poll_interval
+        self.round_trip = round_trip
+        self.window_packets = window_packets
+        self.drop_packet = drop_packet
+        self.reports = 0
+        self.round_trips = 0
+        self.packets_received = 0
+        self.write = None
+
+    @property
+    def elapsed_ms(self):
+        return self.reports * self.poll_interval + self.round_trips * self.round_trip
+
+    def send(self, packet):
+        """Delivers one report from the host, and returns the list of reports sent back.
+        """
+        self.reports += 1
+        self.packets_received += 1
+        if self.drop_packet is not None and self.packets_received == self.drop_packet:
+            return []
+
+        replies = self._receive(bytearray(packet))
+        self.reports += len(replies)
+        if replies:
+            self.round_trips += 1
+
+        return replies
+
+    def _check_request(self, packet):
+        window = self.window_packets * BULK_DATA_SIZE
+        ack = decode_ack(packet)
+        limit = len(self.regions.get(ack['region'], b''))
+
+        packet[6:11] = [STATUS_OK, 0, 0, window >> 8, window & 0xFF]
+        if ack['size'] == 0 or ack['size'] > window or ack['offset'] >= limit or ack['size'] > limit - ack['offset']:
+            packet[6] = STATUS_INVALID_RANGE
+            return None
+
+        return ack
+
+    def _receive(self, packet):
+        command = packet[0]
+
+        for region, (get_command, set_command) in LEGACY_COMMANDS.items():
+            if command in (get_command, set_command):
+                memory = self.regions.get(region, bytearray())
+                offset = (packet[1] << 8) | packet[2]
+                size = packet[3]
+                count = max(0, min(size, len(memory) - offset))
+                if command == get_command:
+                    packet[4:4 + size] = memory[offset:offset + count] + bytes(size - count)
+                else:
+                    memory[offset:offset + count] = packet[4:4 + count]
+                return [packet]
+
+        if command == ID_BULK_READ:
+            request = self._check_request(packet)
+            if not request:
+                return [packet]
+
+            replies = []
+            data = self.regions[request['region']][request['offset']:request['offset'] + request['size']]
+            for sequence, start in enumerate(range(0, len(data), BULK_DATA_SIZE)):
+                chunk = data[start:start + BULK_DATA_SIZE]
+                replies.append(bytearray([ID_BULK_DATA, sequence]) + chunk + bytes(BULK_DATA_SIZE - len(chunk)))
+
+            crc = crc16(data)
+            packet[7:9] = [crc >> 8, crc & 0xFF]
+            replies.append(packet)
+            return replies
+
+        if command == ID_BULK_WRITE:
+            request = self._check_request(packet)
+            self.write = request and {**request, 'status': STATUS_OK, 'sequence': 0, 'received': 0, 'crc': 0xFFFF}
+            return [packet]
+
+        if command == ID_BULK_DATA:
+            write = self.write
+            if not write:
+                ack = bytearray(PACKET_SIZE)
+                ack[0] = ID_BULK_WRITE
+                ack[6] = STATUS_NO_TRANSFER
+                return [ack]
+
+            chunk = packet[2:2 + min(BULK_DATA_SIZE, write['size'] - write['received'])]
+            if packet[1] != write['sequence'] & 0xFF:
+                write['status'] = STATUS_SEQUENCE_ERROR
+            write['sequence'] += 1
+            if write['status'] == STATUS_OK:
+                start = write['offset'] + write['received']
+                self.regions[write['region']][start:start + len(chunk)] = chunk
+                write['crc'] = crc16(chunk, write['crc'])
+            write['received'] += len(chunk)
+            if write['received'] < write['size']:
+                return []
+
+            self.write = None
+            ack = encode_request(ID_BULK_WRITE, write['region'], write['offset'], write['size'])
+            ack[6:9] = [write['status'], write['crc'] >> 8, write['crc'] & 0xFF]
+            return [ack]
+
+        packet[0] = ID_UNHANDLED
+        return [packet]
+
+
+class BulkClient:
+    """Reads and writes keyboard memory with the bulk commands, one window at a time.
+
+    `device` needs a `send(packet)` method returning the list of reports the keyboard sent back.
+    """
+    def __init__(self, device, retries=3):
+        self.device = device
+        self.retries = retries
+        self.window = WINDOW_PACKETS * BULK_DATA_SIZE
+
+    def _request(self, command, region, offset, size):
+        """Sends a request, shrinking the window first if the keyboard reports a smaller one.
+
+        Returns the replies, the last of which is the acknowledgement.
+        """
+        while True:
+            length = min(size, self.window)
+            replies = self.device.send(encode_request(command, region, offset, length))
+            if not replies:
+                return replies, length
+
+            ack = decode_ack(replies[-1])
+            if ack['command'] == ID_UNHANDLED or not ack['window']:
+                raise BulkTransferError('The keyboard does not support bulk transfers')
+            if ack['status'] != STATUS_INVALID_RANGE or ack['window'] >= length:
+                return replies, length
+
+            self.window = ack['window']
+
+    def read(self, region, offset, size):
+        data = bytearray()
+
+        while len(data) < size:
+            start = offset + len(data)
+            for _ in range(self.retries):
+                replies, length = self._request(ID_BULK_READ, region, start, size - len(data))
+                ack = decode_ack(replies[-1]) if replies else None
+                if not ack or ack['status'] != STATUS_OK:
+                    continue
+
+                chunk = bytearray()
+                for sequence, reply in enumerate(replies[:-1]):
+                    if reply[0] == ID_BULK_DATA and reply[1] == sequence & 0xFF:
+                        chunk += reply[2:]
+                chunk = chunk[:length]
+
+                if len(chunk) == length and crc16(chunk) == ack['crc']:
+                    data += chunk
+                    break
+            else:
+                raise BulkTransferError(f'Reading at {start} failed')
+
+        return data
+
+    def write(self, region, offset, data):
+        written = 0
+
+        while written < len(data):
+            start = offset + written
+            for _ in range(self.retries):
+                replies, length = self._request(ID_BULK_WRITE, region, start, len(data) - written)
+                if not replies or decode_ack(replies[-1])['status'] != STATUS_OK:
+                    continue
+
+                chunk = data[written:written + length]
+                for sequence, position in enumerate(range(0, length, BULK_DATA_SIZE)):
+                    payload = chunk[position:position + BULK_DATA_SIZE]
+                    replies = self.device.send(bytearray([ID_BULK_DATA, sequence & 0xFF]) + payload + bytes(BULK_DATA_SIZE - len(payload)))
+
+                ack = decode_ack(replies[-1]) if replies else None
+                if ack and ack['status'] == STATUS_OK and ack['crc'] == crc16(chunk):
+                    written += length
+                    break
+            else:
+                raise BulkTransferError(f'Writing at {start} failed')
+
+
+class LegacyClient:
+    """Reads and writes keyboard memory with id_dynamic_keymap_get_buffer and friends, 28 bytes per round-trip.
+    """
+    def __init__(self, device):
+        self.device = device
+
+    def read(self, region, offset, size):
+        get_command = LEGACY_COMMANDS[region][0]
+        data = bytearray()
+
+        for start in range(offset, offset + size, LEGACY_DATA_SIZE):
+            length = min(LEGACY_DATA_SIZE, offset + size - start)
+            reply = self.device.send(bytearray([get_command, start >> 8, start & 0xFF, length]) + bytes(PACKET_SIZE - 4))[0]
+            data += reply[4:4 + length]
+
+        return data
+
+    def write(self, region, offset, data):
+        set_command = LEGACY_COMMANDS[region][1]
+
+        for position in range(0, len(data), LEGACY_DATA_SIZE):
+            start = offset + position
+            chunk = data[position:position + LEGACY_DATA_SIZE]
+            self.device.send(bytearray([set_command, start >> 8, start & 0xFF, len(chunk)]) + chunk + bytes(PACKET_SIZE - 4 - len(chunk)))
+
+
+def benchmark(regions, poll_interval=1.0, round_trip=1.0, window_packets=WINDOW_PACKETS):
+    """Reads and writes back every region with both protocols against a simulated keyboard.
+
+    Returns a list of dictionaries with the region, protocol, direction, byte count, reports and simulated milliseconds.
+    """
+    results = []
+
+    for region, data in regions.items():
+        protocols = [('bulk', BulkClient)]
+        if region in LEGACY_COMMANDS:
+            protocols.insert(0, ('legacy', LegacyClient))
+
+        for protocol, client_class in protocols:
+            for direction in ('read', 'write'):
+                device = SimulatedKeyboard(regions, poll_interval, round_trip, window_packets)
+                client = client_class(device)
+
+                if direction == 'read':
+                    if client.read(region, 0, len(data)) != data:
+                        raise BulkTransferError(f'{protocol} read of region {region} returned the wrong data')
+                else:
+                    device.regions[region] = bytearray(len(data))
+                    client.write(region, 0, data)
+                    if device.regions[region] != data:
+                        raise BulkTransferError(f'{protocol} write of region {region} stored the wrong data')
+
+                results.append({
+                    'region': region,
+                    'protocol': protocol,
+                    'direction': direction,
+                    'bytes': len(data),
+                    'reports': device.reports,
+                    'ms': device.elapsed_ms,
+                })
+
+    return results
@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "audio.h"
+#include "encoded_song.h"
 #include "eeconfig.h"
 #include "timer.h"
 #include "wait.h"
@@ -81,6 +82,11 @@ uint16_t current_note                 = 0;              // index into the array
 bool     note_resting                 = false;          // if a short pause was introduced between two notes with the same frequency while playing a melody
 uint16_t last_timestamp               = 0;
 
+// encoded SONG related state, see encoded_song.h
+static bool           playing_encoded = false;  // is the melody an encoded one?
+static encoded_song_t encoded_song;             // position of the next note
+static uint8_t        encoded_note;             // the note currently playing
+
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
 #    ifndef AUDIO_MAX_SIMULTANEOUS_TONES
 #        define AUDIO_MAX_SIMULTANEOUS_TONES 3
@@ -303,8 +309,9 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
     // Cancel note if a note is playing
     if (playing_note) audio_stop_all();
 
-    playing_melody = true;
-    note_resting   = false;
+    playing_melody  = true;
+    playing_encoded = false;
+    note_resting    = false;
 
     notes_pointer = np;
     notes_count   = n_count;
@@ -319,6 +326,92 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
     melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
 }
 
+void audio_play_encoded_melody(const uint8_t *song, uint16_t length, bool repeat) {
+    if (!audio_config.enable) {
+        audio_stop_all();
+        return;
+    }
+
+    if (!audio_initialized) {
+        audio_init();
+    }
+
+    // Cancel note if a note is playing
+    if (playing_note) audio_stop_all();
+
+    uint8_t duration;
+    encoded_song_init(&encoded_song, song, length);
+    if (!encoded_song_next(&encoded_song, &encoded_note, &duration)) {
+        return;
+    }
+
+    playing_melody  = true;
+    playing_encoded = true;
+    note_resting    = false;
+    notes_repeat    = repeat;
+
+    // start first note manually, which also starts the audio_driver
+    // all following/remaining notes are played by 'audio_update_state'
+    melody_current_note_duration = encoded_song_duration_to_ms(duration, note_tempo);
+    audio_play_note(encoded_song_note_frequency(encoded_note), melody_current_note_duration);
+    last_timestamp = timer_read();
+}
+
+/* the encoded counterpart of the SONG handling in 'audio_update_state', which
+ * only does integer math
+ *
+ * @return false if the melody ended
+ */
+static bool audio_next_encoded_note(uint16_t delta) {
+    encoded_song_t next = encoded_song;
+    uint8_t        note, duration;
+
+    if (!encoded_song_next(&next, &note, &duration)) {
+        if (!notes_repeat) {
+            audio_stop_all();
+            return false;
+        }
+        encoded_song_init(&next, encoded_song.data, encoded_song.length);
+        encoded_song_next(&next, &note, &duration);
+    }
+
+    if (!note_resting && note == encoded_note) {
+        note_resting = true;
+
+        // special handling for successive notes of the same frequency:
+        // insert a short pause to separate them audibly, and play the note after it
+        melody_current_note_duration = encoded_song_duration_to_ms(2, note_tempo);
+        audio_play_note(0.0f, melody_current_note_duration);
+        return true;
+    }
+    note_resting = false;
+
+    uint16_t duration_ms = encoded_song_duration_to_ms(duration, note_tempo);
+
+    // Skip forward past any completely missed notes
+    encoded_song_t following = next;
+    uint8_t        following_note, following_duration;
+    while (delta > duration_ms && encoded_song_next(&following, &following_note, &following_duration)) {
+        delta -= duration_ms;
+        next        = following;
+        note        = following_note;
+        duration_ms = encoded_song_duration_to_ms(following_duration, note_tempo);
+    }
+
+    if (delta < duration_ms) {
+        duration_ms -= delta;
+    } else {
+        // the last note was missed completely, play it for 1ms
+        duration_ms = 1;
+    }
+
+    encoded_song = next;
+    encoded_note = note;
+    audio_play_note(encoded_song_note_frequency(note), duration_ms);
+    melody_current_note_duration = duration_ms;
+    return true;
+}
+
 float click[2][2];
 void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
     uint16_t duration_tone  = audio_ms_to_duration(duration);
@@ -386,64 +479,71 @@ bool audio_update_state(void) {
     if (playing_melody) {
         goto_next_note = timer_elapsed(last_timestamp) >= melody_current_note_duration;
         if (goto_next_note) {
-            uint16_t delta         = timer_elapsed(last_timestamp) - melody_current_note_duration;
-            last_timestamp         = current_time;
-            uint16_t previous_note = current_note;
-            current_note++;
-            voices_timer = timer_read();  // reset to zero, for the effects added by voices.c
-
-            if (current_note >= notes_count) {
-                if (notes_repeat) {
-                    current_note = 0;
-                } else {
-                    audio_stop_all();
+            uint16_t delta = timer_elapsed(last_timestamp) - melody_current_note_duration;
+            last_timestamp = current_time;
+            voices_timer   = timer_read();  // reset to zero, for the effects added by voices.c
+
+            if (playing_encoded) {
+                if (!audio_next_encoded_note(delta)) {
                     return false;
                 }
-            }
-
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
-                note_resting = true;
-
-                // special handling for successive notes of the same frequency:
-                // insert a short pause to separate them audibly
-                audio_play_note(0.0f, audio_duration_to_ms(2));
-                current_note                 = previous_note;
-                melody_current_note_duration = audio_duration_to_ms(2);
-
             } else {
-                note_resting = false;
-
-                // TODO: handle glissando here (or remember previous and current tone)
-                /* there would need to be a freq(here we are) -> freq(next note)
-                 * and do slide/glissando in between problem here is to know which
-                 * frequency on the stack relates to what other? e.g. a melody starts
-                 * tones in a sequence, and stops expiring one, so the most recently
-                 * stopped is the starting point for a glissando to the most recently started?
-                 * how to detect and preserve this relation?
-                 * and what about user input, chords, ...?
-                 */
-
-                // '- delta': Skip forward in the next note's length if we've over shot
-                //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
-
-                // Skip forward past any completely missed notes
-                while (delta > duration && current_note < notes_count - 1) {
-                    delta -= duration;
-                    current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                uint16_t previous_note = current_note;
+                current_note++;
+
+                if (current_note >= notes_count) {
+                    if (notes_repeat) {
+                        current_note = 0;
+                    } else {
+                        audio_stop_all();
+                        return false;
+                    }
                 }
 
-                if (delta < duration) {
-                    duration -= delta;
+                if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+                    note_resting = true;
+
+                    // special handling for successive notes of the same frequency:
+                    // insert a short pause to separate them audibly
+                    audio_play_note(0.0f, audio_duration_to_ms(2));
+                    current_note                 = previous_note;
+                    melody_current_note_duration = audio_duration_to_ms(2);
+
                 } else {
-                    // Only way to get here is if it is the last note and
-                    // we have completely missed it. Play it for 1ms...
-                    duration = 1;
+                    note_resting = false;
+
+                    // TODO: handle glissando here (or remember previous and current tone)
+                    /* there would need to be a freq(here we are) -> freq(next note)
+                     * and do slide/glissando in between problem here is to know which
+                     * frequency on the stack relates to what other? e.g. a melody starts
+                     * tones in a sequence, and stops expiring one, so the most recently
+                     * stopped is the starting point for a glissando to the most recently started?
+                     * how to detect and preserve this relation?
+                     * and what about user input, chords, ...?
+                     */
+
+                    // '- delta': Skip forward in the next note's length if we've over shot
+                    //            the last, so the overall length of the song is the same
+                    uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+
+                    // Skip forward past any completely missed notes
+                    while (delta > duration && current_note < notes_count - 1) {
+                        delta -= duration;
+                        current_note++;
+                        duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                    }
+
+                    if (delta < duration) {
+                        duration -= delta;
+                    } else {
+                        // Only way to get here is if it is the last note and
+                        // we have completely missed it. Play it for 1ms...
+                        duration = 1;
+                    }
+
+                    audio_play_note((*notes_pointer)[current_note][0], duration);
+                    melody_current_note_duration = duration;
                 }
-
-                audio_play_note((*notes_pointer)[current_note][0], duration);
-                melody_current_note_duration = duration;
             }
         }
     }
@@ -147,6 +147,19 @@ void audio_stop_tone(float pitch);
  */
 void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
 
+/**
+ * @brief play an encoded melody
+ *
+ * @details starts playback of a melody generated by 'qmk generate-encoded-songs',
+ *          which takes one or two bytes of flash per note instead of eight, and
+ *          is played back without float math - see encoded_song.h
+ *
+ * @param[in] song the PROGMEM array of the encoded melody
+ * @param[in] length in bytes
+ * @param[in] repeat false for onetime, true for looped playback
+ */
+void audio_play_encoded_melody(const uint8_t *song, uint16_t length, bool repeat);
+
 /**
  * @brief play a short tone of a specific frequency to emulate a 'click'
  *
@@ -193,6 +206,12 @@ bool audio_is_playing_melody(void);
  */
 #define PLAY_LOOP(note_array) audio_play_melody(&note_array, NOTE_ARRAY_SIZE((note_array)), true)
 
+/**
+ * @brief convenience macros, to play an encoded melody once or in a loop
+ */
+#define PLAY_ENCODED_SONG(encoded_song) audio_play_encoded_melody(encoded_song, sizeof(encoded_song), false)
+#define PLAY_ENCODED_LOOP(encoded_song) audio_play_encoded_melody(encoded_song, sizeof(encoded_song), true)
+
 // Tone-Multiplexing functions
 // this feature only makes sense for hardware setups which can't do proper
 // audio-wave synthesis = have no DAC and need to use PWM for tone generation
@@ -16,6 +16,7 @@
  */
 
 #include "audio.h"
+#include "wavetable_synth.h"
 #include <ch.h>
 #include <hal.h>
 
@@ -26,7 +27,8 @@
 
   it is also possible to have a custom sample-LUT by implementing/overriding 'dac_value_generate'
 
-  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis
+  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis,
+  with the fixed-point phase accumulators in wavetable_synth.c
 */
 
 #if !defined(AUDIO_PIN)
@@ -81,10 +83,23 @@ static const dacsample_t dac_buffer_trapezoid[AUDIO_DAC_BUFFER_SIZE] = {0x0,   0
 
 static dacsample_t dac_buffer_empty[AUDIO_DAC_BUFFER_SIZE] = {AUDIO_DAC_OFF_VALUE};
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define DAC_WAVETABLE dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define DAC_WAVETABLE dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define DAC_WAVETABLE dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define DAC_WAVETABLE dac_buffer_square
+#endif
+
+/*Note: the gpt timer runs with 3*AUDIO_DAC_SAMPLE_RATE, and the DAC callback is called
+ *      twice per conversion, so samples are output at 3/2 of AUDIO_DAC_SAMPLE_RATE
+ *      (as measured with an oscilloscope).*/
+#define DAC_OUTPUT_SAMPLE_RATE (AUDIO_DAC_SAMPLE_RATE * 3 / 2)
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0, 0};
+/* index of the tone each synthesizer voice plays, for the control rate frequency updates */
+static uint8_t active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
 static uint8_t active_tones_snapshot_length                        = 0;
 
 typedef enum {
@@ -114,51 +129,28 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     }
 
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint16_t value     = 0;
-    float    frequency = 0.0f;
-
-    for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        dac_if[i] = dac_if[i] + ((frequency * AUDIO_DAC_BUFFER_SIZE) / AUDIO_DAC_SAMPLE_RATE) * 2 / 3;
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        dac_if[i] = fmod(dac_if[i], AUDIO_DAC_BUFFER_SIZE);
-
-        // Wavetable generation/lookup
-        uint16_t dac_i = (uint16_t)dac_if[i];
+     * wavetable-samples for each frequency, scaled by the number of active tones
+     *
+     * Note: a user implementation does not have to rely on the synthesizer, but
+     * could directly query the active frequencies through audio_get_processed_frequency */
+    return wavetable_synth_next_sample();
+}
 
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+/**
+ * Control rate update of the voices: follows the frequency envelopes (vibrato, glides, ...)
+ * of the tones currently playing, and fades in voices that just started.
+ */
+static void dac_voices_update(void) {
+    if (OUTPUT_RUN_NORMALLY == state) {
+        for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
+            float freq = audio_get_processed_frequency(active_tones_snapshot[i]);
+            if (freq > 0) {
+                wavetable_synth_set_frequency(i, freq);
+            }
+        }
     }
 
-    return value;
+    wavetable_synth_update_envelopes();
 }
 
 /**
@@ -174,6 +166,8 @@ static void dac_end(DACDriver *dacp) {
         sample_p += AUDIO_DAC_BUFFER_SIZE / 2;  // 'half_index'
     }
 
+    dac_voices_update();
+
     for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
         if (OUTPUT_OFF <= state) {
             sample_p[s] = AUDIO_DAC_OFF_VALUE;
@@ -221,9 +215,11 @@ static void dac_end(DACDriver *dacp) {
             for (uint8_t i = 0; i < active_tones; i++) {
                 float freq = audio_get_processed_frequency(i);
                 if (freq > 0) {  // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
+                    wavetable_synth_set_frequency(active_tones_snapshot_length, freq);
+                    active_tones_snapshot[active_tones_snapshot_length++] = i;
                 }
             }
+            wavetable_synth_set_voice_count(active_tones_snapshot_length);
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
@@ -318,6 +314,8 @@ void audio_driver_initialize() {
     }
 #endif
 
+    wavetable_synth_init(DAC_WAVETABLE, AUDIO_DAC_BUFFER_SIZE, DAC_OUTPUT_SAMPLE_RATE);
+
     gptStart(&GPTD6, &gpt6cfg1);
 }
 
@@ -326,10 +324,7 @@ void audio_driver_stop(void) { state = OUTPUT_SHOULD_STOP; }
 void audio_driver_start(void) {
     gptStartContinuous(&GPTD6, 2U);
 
-    for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
-    }
+    wavetable_synth_set_voice_count(0);
     active_tones_snapshot_length = 0;
     state                        = OUTPUT_SHOULD_START;
 }
@@ -0,0 +1,66 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Encoded songs are PROGMEM byte arrays, generated from the SONG macros by
+ * `qmk generate-encoded-songs`. Every note takes one or two bytes instead of
+ * the two floats of a SONG array:
+ *
+ *   note byte      bit 7 set if a duration byte follows, bits 0-6 the note:
+ *                  0 is a rest, 1 is C0, 2 is CS0, ... up to 108 for B8
+ *   duration byte  length of the note in the 64-parts-to-a-beat unit of
+ *                  musical_notes.h, 1 to 255
+ *
+ * A note without a duration byte is as long as the one before it.
+ */
+
+#define ENCODED_SONG_REST 0
+#define ENCODED_SONG_NOTE_COUNT 108
+#define ENCODED_SONG_NOTE_MASK 0x7F
+#define ENCODED_SONG_HAS_DURATION 0x80
+
+typedef struct {
+    const uint8_t *data;  // in PROGMEM
+    uint16_t       length;
+    uint16_t       position;
+    uint8_t        duration;
+} encoded_song_t;
+
+void encoded_song_init(encoded_song_t *song, const uint8_t *data, uint16_t length);
+
+/**
+ * Reads the next note of the song.
+ *
+ * Copying the encoded_song_t beforehand allows looking ahead without moving the original.
+ *
+ * @return false at the end of the song
+ */
+bool encoded_song_next(encoded_song_t *song, uint8_t *note, uint8_t *duration);
+
+/**
+ * @return the frequency of a note, as defined in musical_notes.h; 0.0f for rests
+ */
+float encoded_song_note_frequency(uint8_t note);
+
+/**
+ * Converts a duration in the musical_notes.h unit to milliseconds, in integer math.
+ */
+uint16_t encoded_song_duration_to_ms(uint8_t duration, uint8_t tempo);
@@ -0,0 +1,128 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "encoded_song.h"
+#include "progmem.h"
+#include "song_list.h"
+#include "encoded_songs.h"
+}
+
+#define NOTE_ARRAY_SIZE(x) ((int16_t)(sizeof(x) / (sizeof(x[0]))))
+
+static float ode_to_joy[][2]         = SONG(ODE_TO_JOY);
+static float planck_sound[][2]       = SONG(PLANCK_SOUND);
+static float colemak_sound[][2]      = SONG(COLEMAK_SOUND);
+static float nocturne_op_9_no_1[][2] = SONG(NOCTURNE_OP_9_NO_1);
+
+// audio_duration_to_ms as it was before encoded songs, for AVR and for everything else
+static uint16_t avr_duration_to_ms(uint16_t duration_bpm, uint8_t note_tempo) { return ((uint32_t)duration_bpm * 60 * 1000) / (64 * note_tempo); }
+static uint16_t float_duration_to_ms(uint16_t duration_bpm, uint8_t note_tempo) { return ((float)duration_bpm * 60) / (64 * note_tempo) * 1000; }
+
+class EncodedSong : public ::testing::Test {
+   protected:
+    void expect_same_song(float (*notes)[][2], uint16_t note_count, const uint8_t *encoded, uint16_t length) {
+        for (uint8_t tempo = 10; tempo != 0; tempo++) {
+            encoded_song_t song;
+            encoded_song_init(&song, encoded, length);
+
+            uint32_t encoded_ms = 0, avr_ms = 0, float_ms = 0;
+            for (uint16_t i = 0; i < note_count; i++) {
+                uint8_t note, duration;
+                ASSERT_TRUE(encoded_song_next(&song, &note, &duration)) << "song ended after " << i << " notes";
+
+                EXPECT_EQ(encoded_song_note_frequency(note), (*notes)[i][0]) << "note " << i;
+                EXPECT_EQ(duration, (*notes)[i][1]) << "note " << i;
+
+                uint16_t ms = encoded_song_duration_to_ms(duration, tempo);
+                EXPECT_EQ(ms, avr_duration_to_ms((*notes)[i][1], tempo));
+                EXPECT_NEAR(ms, float_duration_to_ms((*notes)[i][1], tempo), 1);
+
+                encoded_ms += ms;
+                avr_ms += avr_duration_to_ms((*notes)[i][1], tempo);
+                float_ms += float_duration_to_ms((*notes)[i][1], tempo);
+            }
+
+            uint8_t note, duration;
+            EXPECT_FALSE(encoded_song_next(&song, &note, &duration));
+
+            EXPECT_EQ(encoded_ms, avr_ms) << "at tempo " << (int)tempo;
+            EXPECT_NEAR(encoded_ms, float_ms, note_count / 100 + 1) << "at tempo " << (int)tempo;
+        }
+    }
+};
+
+TEST_F(EncodedSong, MatchesSongArrays) {
+    expect_same_song(&ode_to_joy, NOTE_ARRAY_SIZE(ode_to_joy), ode_to_joy_encoded, sizeof(ode_to_joy_encoded));
+    expect_same_song(&planck_sound, NOTE_ARRAY_SIZE(planck_sound), planck_sound_encoded, sizeof(planck_sound_encoded));
+    expect_same_song(&colemak_sound, NOTE_ARRAY_SIZE(colemak_sound), colemak_sound_encoded, sizeof(colemak_sound_encoded));
+    expect_same_song(&nocturne_op_9_no_1, NOTE_ARRAY_SIZE(nocturne_op_9_no_1), nocturne_op_9_no_1_encoded, sizeof(nocturne_op_9_no_1_encoded));
+}
+
+TEST_F(EncodedSong, IsSmallerThanSongArrays) {
+    EXPECT_LE(sizeof(ode_to_joy_encoded), 2 * NOTE_ARRAY_SIZE(ode_to_joy));
+    EXPECT_LE(sizeof(nocturne_op_9_no_1_encoded), 2 * NOTE_ARRAY_SIZE(nocturne_op_9_no_1));
+    EXPECT_LT(sizeof(nocturne_op_9_no_1_encoded) * 6, sizeof(nocturne_op_9_no_1));
+}
+
+TEST_F(EncodedSong, DurationCarriesOver) {
+    const uint8_t  data[] = {ENCODED_SONG_HAS_DURATION | 1, 16, 2, ENCODED_SONG_REST, ENCODED_SONG_HAS_DURATION | ENCODED_SONG_NOTE_COUNT, 255};
+    encoded_song_t song;
+    uint8_t        note, duration;
+
+    encoded_song_init(&song, data, sizeof(data));
+    ASSERT_TRUE(encoded_song_next(&song, &note, &duration));
+    EXPECT_EQ(note, 1);
+    EXPECT_EQ(duration, 16);
+    EXPECT_EQ(encoded_song_note_frequency(note), NOTE_C0);
+
+    // looking ahead on a copy leaves the original where it was
+    encoded_song_t ahead = song;
+    ASSERT_TRUE(encoded_song_next(&ahead, &note, &duration));
+    ASSERT_TRUE(encoded_song_next(&song, &note, &duration));
+    EXPECT_EQ(note, 2);
+    EXPECT_EQ(duration, 16);
+
+    ASSERT_TRUE(encoded_song_next(&song, &note, &duration));
+    EXPECT_EQ(note, ENCODED_SONG_REST);
+    EXPECT_EQ(duration, 16);
+    EXPECT_EQ(encoded_song_note_frequency(note), NOTE_REST);
+
+    ASSERT_TRUE(encoded_song_next(&song, &note, &duration));
+    EXPECT_EQ(duration, 255);
+    EXPECT_EQ(encoded_song_note_frequency(note), NOTE_B8);
+
+    EXPECT_FALSE(encoded_song_next(&song, &note, &duration));
+}
+
+TEST_F(EncodedSong, TruncatedSong) {
+    // a duration byte missing at the end keeps the previous duration, instead of reading past the song
+    const uint8_t  data[] = {ENCODED_SONG_HAS_DURATION | 1, 8, ENCODED_SONG_HAS_DURATION | 2};
+    encoded_song_t song;
+    uint8_t        note, duration;
+
+    encoded_song_init(&song, data, sizeof(data));
+    ASSERT_TRUE(encoded_song_next(&song, &note, &duration));
+    ASSERT_TRUE(encoded_song_next(&song, &note, &duration));
+    EXPECT_EQ(note, 2);
+    EXPECT_EQ(duration, 8);
+    EXPECT_FALSE(encoded_song_next(&song, &note, &duration));
+
+    encoded_song_init(&song, data, 0);
+    EXPECT_FALSE(encoded_song_next(&song, &note, &duration));
+}
@@ -0,0 +1,32 @@
+/* This file was generated by `qmk generate-encoded-songs`. Do not edit or copy.
+ */
+
+#pragma once
+
+// clang-format off
+
+// ODE_TO_JOY: 15 notes in 19 bytes
+const uint8_t PROGMEM ode_to_joy_encoded[] = {
+    0xB5, 0x10, 0x35, 0x36, 0x38, 0x38, 0x36, 0x35, 0x33, 0x31, 0x31, 0x33, 0x35, 0xB5, 0x18, 0xB3,
+    0x08, 0xB3, 0x20,
+};
+
+// PLANCK_SOUND: 5 notes in 8 bytes
+const uint8_t PROGMEM planck_sound_encoded[] = {
+    0xD9, 0x0C, 0xD6, 0x08, 0x4D, 0x52, 0xD6, 0x14,
+};
+
+// COLEMAK_SOUND: 6 notes in 11 bytes
+const uint8_t PROGMEM colemak_sound_encoded[] = {
+    0xD1, 0x08, 0x52, 0x80, 0x04, 0xD9, 0x0C, 0x80, 0x04, 0xDD, 0x0C,
+};
+
+// NOCTURNE_OP_9_NO_1: 75 notes in 93 bytes
+const uint8_t PROGMEM nocturne_op_9_no_1_encoded[] = {
+    0xC7, 0x20, 0x49, 0x4A, 0x46, 0x47, 0x43, 0xC2, 0x40, 0x42, 0x42, 0x42, 0xC3, 0x20, 0x42, 0x40,
+    0x3D, 0xBE, 0x80, 0xBB, 0x40, 0xC7, 0x10, 0x49, 0x4A, 0x46, 0x47, 0x46, 0x45, 0x46, 0x49, 0x47,
+    0x43, 0x42, 0x43, 0x41, 0x42, 0x47, 0x46, 0x45, 0x44, 0x43, 0x42, 0x41, 0x40, 0x3F, 0x3E, 0x3D,
+    0x3E, 0x3D, 0x3C, 0x3D, 0x42, 0x41, 0x40, 0xBE, 0x80, 0xBB, 0x40, 0x47, 0x47, 0x47, 0xC5, 0xC0,
+    0xBE, 0x40, 0xBB, 0x20, 0x3D, 0x3E, 0x43, 0x43, 0xC2, 0xC0, 0xC0, 0x40, 0xC2, 0x20, 0x40, 0x3E,
+    0x3A, 0xB9, 0x80, 0xBE, 0x40, 0x40, 0xC2, 0x20, 0x40, 0x3E, 0x40, 0xC2, 0xC0,
+};
@@ -0,0 +1,11 @@
+wavetable_synth_DEFS := -DNO_DEBUG
+
+wavetable_synth_SRC := \
+	$(QUANTUM_PATH)/audio/tests/wavetable_synth_tests.cpp \
+	$(QUANTUM_PATH)/audio/wavetable_synth.c
+
+encoded_song_DEFS := -DNO_DEBUG
+
+encoded_song_SRC := \
+	$(QUANTUM_PATH)/audio/tests/encoded_song_tests.cpp \
+	$(QUANTUM_PATH)/audio/encoded_song.c
@@ -0,0 +1,2 @@
+TEST_LIST += wavetable_synth
+TEST_LIST += encoded_song
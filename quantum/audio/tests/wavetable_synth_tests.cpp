@@ -0,0 +1,175 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include "wavetable_synth.h"
+}
+
+#define TABLE_SIZE 256
+#define TABLE_CENTER 2048
+#define BLOCK_SIZE 128
+
+class WavetableSynth : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            sine[i] = (uint16_t)lround(TABLE_CENTER + 2047 * sin(2 * M_PI * i / TABLE_SIZE));
+        }
+    }
+
+    void init(uint32_t sample_rate) {
+        this->sample_rate = sample_rate;
+        wavetable_synth_init(sine, TABLE_SIZE, sample_rate);
+    }
+
+    // Renders `seconds` of audio in blocks, updating the envelopes at control rate like the driver does
+    std::vector<uint16_t> render(double seconds) {
+        std::vector<uint16_t> samples(lround(seconds * sample_rate / BLOCK_SIZE) * BLOCK_SIZE);
+        for (size_t i = 0; i < samples.size(); i += BLOCK_SIZE) {
+            wavetable_synth_update_envelopes();
+            wavetable_synth_render(&samples[i], BLOCK_SIZE);
+        }
+        return samples;
+    }
+
+    // Estimates the frequency from the first and last rising zero crossing, interpolated between samples
+    double measure_frequency(const std::vector<uint16_t>& samples) {
+        double first = -1, last = -1;
+        int    crossings = 0;
+
+        for (size_t i = 1; i < samples.size(); i++) {
+            int before = samples[i - 1] - TABLE_CENTER;
+            int after  = samples[i] - TABLE_CENTER;
+            if (before < 0 && after >= 0) {
+                double position = i - 1 + (double)-before / (after - before);
+                if (first < 0) {
+                    first = position;
+                } else {
+                    crossings++;
+                }
+                last = position;
+            }
+        }
+
+        return crossings * (double)sample_rate / (last - first);
+    }
+
+    uint16_t sine[TABLE_SIZE];
+    uint32_t sample_rate;
+};
+
+TEST_F(WavetableSynth, SilentWithoutVoices) {
+    init(44100);
+    for (uint16_t sample : render(0.01)) {
+        EXPECT_EQ(sample, TABLE_CENTER);
+    }
+}
+
+TEST_F(WavetableSynth, FrequencyAccuracy) {
+    const float notes[] = {65.41f, 261.63f, 440.0f, 1000.0f, 4186.01f, 7902.13f};
+
+    // the output rates of the dac_additive driver at the default and the highest quality settings
+    for (uint32_t sample_rate : {16384U * 3 / 2, 88200U * 3 / 2}) {
+        for (float note : notes) {
+            init(sample_rate);
+            wavetable_synth_set_frequency(0, note);
+            wavetable_synth_set_voice_count(1);
+
+            double frequency = measure_frequency(render(1.0));
+            EXPECT_NEAR(frequency, note, note * 0.0001) << "at " << sample_rate << " Hz";
+        }
+    }
+}
+
+TEST_F(WavetableSynth, FullVolumeMatchesWavetable) {
+    init(44100);
+    wavetable_synth_set_frequency(0, 44100.0f / TABLE_SIZE);
+    wavetable_synth_set_voice_count(1);
+    for (int i = 0; i < 4; i++) {
+        wavetable_synth_update_envelopes();
+    }
+
+    // one table step per sample
+    for (int i = 0; i < 2 * TABLE_SIZE; i++) {
+        EXPECT_EQ(wavetable_synth_next_sample(), sine[i % TABLE_SIZE]);
+    }
+}
+
+TEST_F(WavetableSynth, VoicesFadeIn) {
+    init(44100);
+    wavetable_synth_set_frequency(0, 1000.0f);
+    wavetable_synth_set_voice_count(1);
+
+    // a new voice starts at the silent level, and is louder after every envelope update until it reaches full volume
+    EXPECT_EQ(wavetable_synth_next_sample(), TABLE_CENTER);
+
+    int previous_peak = 0;
+    for (int block = 0; block < WAVETABLE_SYNTH_GAIN_MAX / WAVETABLE_SYNTH_ATTACK_STEP; block++) {
+        std::vector<uint16_t> samples = render((double)BLOCK_SIZE / sample_rate);
+        int                   peak    = 0;
+        for (uint16_t sample : samples) {
+            peak = std::max(peak, std::abs(sample - TABLE_CENTER));
+        }
+        EXPECT_GT(peak, previous_peak);
+        previous_peak = peak;
+    }
+    EXPECT_NEAR(previous_peak, 2047, 10);
+}
+
+TEST_F(WavetableSynth, VoicesAreMixed) {
+    init(44100);
+    wavetable_synth_set_frequency(0, 440.0f);
+    wavetable_synth_set_frequency(1, 440.0f * 3 / 2);
+    wavetable_synth_set_frequency(2, 440.0f * 5 / 4);
+    wavetable_synth_set_voice_count(3);
+    EXPECT_EQ(wavetable_synth_get_voice_count(), 3);
+
+    std::vector<uint16_t> samples = render(0.5);
+    int                   low = TABLE_CENTER, high = TABLE_CENTER;
+    for (uint16_t sample : samples) {
+        low  = std::min(low, (int)sample);
+        high = std::max(high, (int)sample);
+    }
+
+    // scaled by the number of voices, the mix never exceeds the range of the table
+    EXPECT_GE(low, 0);
+    EXPECT_LE(high, 4095);
+    EXPECT_GT(high - low, 2048);
+
+    // voices beyond the maximum are ignored
+    wavetable_synth_set_voice_count(WAVETABLE_SYNTH_MAX_VOICES + 1);
+    EXPECT_EQ(wavetable_synth_get_voice_count(), WAVETABLE_SYNTH_MAX_VOICES);
+}
+
+TEST_F(WavetableSynth, FrequencyChangeKeepsPhase) {
+    init(44100);
+    wavetable_synth_set_frequency(0, 440.0f);
+    wavetable_synth_set_voice_count(1);
+    std::vector<uint16_t> before = render(0.1);
+
+    wavetable_synth_set_frequency(0, 880.0f);
+    uint16_t next = wavetable_synth_next_sample();
+
+    // no jump larger than a step at the new frequency
+    double max_step = 2047 * 2 * M_PI * 880.0 / sample_rate;
+    EXPECT_LE(std::abs(next - before.back()), max_step + 1);
+}
@@ -0,0 +1,96 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "wavetable_synth.h"
+
+static wavetable_voice_t voices[WAVETABLE_SYNTH_MAX_VOICES];
+static uint8_t           voice_count;
+
+static const uint16_t *wavetable;
+static uint32_t        phase_mask;
+static int32_t         center;
+static float           increment_per_hz;
+// Q16 reciprocal of voice_count, so mixing needs no division
+static int32_t mix_gain;
+
+void wavetable_synth_init(const uint16_t *table, uint16_t size, uint32_t sample_rate) {
+    uint16_t low = UINT16_MAX, high = 0;
+    for (uint16_t i = 0; i < size; i++) {
+        if (table[i] < low) low = table[i];
+        if (table[i] > high) high = table[i];
+    }
+
+    wavetable        = table;
+    phase_mask       = ((uint32_t)size << 16) - 1;
+    center           = (low + high) / 2;
+    increment_per_hz = (float)size * 65536.0f / sample_rate;
+
+    voice_count = 0;
+    wavetable_synth_set_voice_count(0);
+}
+
+void wavetable_synth_set_voice_count(uint8_t count) {
+    if (count > WAVETABLE_SYNTH_MAX_VOICES) {
+        count = WAVETABLE_SYNTH_MAX_VOICES;
+    }
+
+    for (uint8_t i = voice_count; i < count; i++) {
+        voices[i].phase = 0;
+        voices[i].gain  = 0;
+    }
+
+    voice_count = count;
+    mix_gain    = count ? WAVETABLE_SYNTH_GAIN_MAX / count : 0;
+}
+
+uint8_t wavetable_synth_get_voice_count(void) { return voice_count; }
+
+void wavetable_synth_set_frequency(uint8_t voice, float frequency) {
+    if (voice < WAVETABLE_SYNTH_MAX_VOICES) {
+        voices[voice].increment = (uint32_t)(frequency * increment_per_hz + 0.5f);
+    }
+}
+
+void wavetable_synth_update_envelopes(void) {
+    for (uint8_t i = 0; i < voice_count; i++) {
+        if (voices[i].gain < WAVETABLE_SYNTH_GAIN_MAX - WAVETABLE_SYNTH_ATTACK_STEP) {
+            voices[i].gain += WAVETABLE_SYNTH_ATTACK_STEP;
+        } else {
+            voices[i].gain = WAVETABLE_SYNTH_GAIN_MAX;
+        }
+    }
+}
+
+uint16_t wavetable_synth_next_sample(void) {
+    int32_t sum = 0;
+
+    for (uint8_t i = 0; i < voice_count; i++) {
+        wavetable_voice_t *voice = &voices[i];
+
+        int32_t value = (int32_t)wavetable[voice->phase >> 16] - center;
+        sum += (value * (int32_t)voice->gain) / (int32_t)WAVETABLE_SYNTH_GAIN_MAX;
+
+        voice->phase = (voice->phase + voice->increment) & phase_mask;
+    }
+
+    return center + (sum * mix_gain) / (int32_t)WAVETABLE_SYNTH_GAIN_MAX;
+}
+
+void wavetable_synth_render(uint16_t *buffer, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        buffer[i] = wavetable_synth_next_sample();
+    }
+}
@@ -0,0 +1,87 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef AUDIO_DRIVER_DAC
+// for the AUDIO_MAX_SIMULTANEOUS_TONES of the selected quality preset
+#    include "driver_chibios_dac.h"
+#endif
+
+/*
+ * Fixed-point wavetable synthesis, as used by the dac_additive audio driver.
+ *
+ * Every voice steps through the same wavetable with a Q16.16 phase accumulator,
+ * so rendering a sample only takes integer additions, one table lookup and one
+ * multiplication per voice. Frequencies and envelopes are updated at control
+ * rate (once per rendered block), which is also the only place floats are used.
+ */
+
+#ifndef WAVETABLE_SYNTH_MAX_VOICES
+#    ifdef AUDIO_MAX_SIMULTANEOUS_TONES
+#        define WAVETABLE_SYNTH_MAX_VOICES AUDIO_MAX_SIMULTANEOUS_TONES
+#    else
+#        define WAVETABLE_SYNTH_MAX_VOICES 8
+#    endif
+#endif
+
+/* Q16 gain added to a starting voice per envelope update, until it reaches full volume */
+#ifndef WAVETABLE_SYNTH_ATTACK_STEP
+#    define WAVETABLE_SYNTH_ATTACK_STEP 0x4000
+#endif
+
+#define WAVETABLE_SYNTH_GAIN_MAX 0x10000UL
+
+typedef struct {
+    uint32_t phase;      // Q16.16 position in the wavetable
+    uint32_t increment;  // Q16.16 wavetable steps per sample
+    uint32_t gain;       // Q16, WAVETABLE_SYNTH_GAIN_MAX is full volume
+} wavetable_voice_t;
+
+/**
+ * Selects the wavetable and the sample rate the voices are rendered at, and silences all voices.
+ *
+ * `size` has to be a power of two. The midpoint between the smallest and largest
+ * table value is used as the silent level.
+ */
+void wavetable_synth_init(const uint16_t *table, uint16_t size, uint32_t sample_rate);
+
+/**
+ * Sets the number of sounding voices. Voices that were not sounding before start
+ * from the beginning of the wavetable and fade in over a few envelope updates.
+ */
+void wavetable_synth_set_voice_count(uint8_t count);
+
+uint8_t wavetable_synth_get_voice_count(void);
+
+/**
+ * Sets the frequency of a voice, keeping its phase, so glides and vibrato are continuous.
+ */
+void wavetable_synth_set_frequency(uint8_t voice, float frequency);
+
+/**
+ * Advances the voice envelopes by one step. Call once per rendered block.
+ */
+void wavetable_synth_update_envelopes(void);
+
+/**
+ * Returns the next sample of all sounding voices mixed together.
+ */
+uint16_t wavetable_synth_next_sample(void);
+
+void wavetable_synth_render(uint16_t *buffer, uint16_t length);
@@ -6,6 +6,18 @@
 #ifndef BACKLIGHT_GPT_DRIVER
 #    define BACKLIGHT_GPT_DRIVER GPTD15
 #endif
+#ifndef BACKLIGHT_TIMER_FREQUENCY
+#    define BACKLIGHT_TIMER_FREQUENCY 1000000
+#endif
+#ifndef BACKLIGHT_PWM_PERIOD
+#    define BACKLIGHT_PWM_PERIOD 1024  // in timer ticks, ~1kHz at the default frequency
+#endif
+#if BACKLIGHT_PWM_PERIOD < 256 || BACKLIGHT_PWM_PERIOD > 0xFFFF
+#    error "BACKLIGHT_PWM_PERIOD must be between 256 and 65535"
+#endif
+
+// PWM cycles per breathing step, so that breathing steps at about 256Hz
+#define BREATHING_CYCLES ((BACKLIGHT_TIMER_FREQUENCY + BACKLIGHT_PWM_PERIOD * 128UL) / (BACKLIGHT_PWM_PERIOD * 256UL))
 
 // Platform specific implementations
 static void     backlight_timer_configure(bool enable);
@@ -43,15 +55,18 @@ void backlight_init_ports(void) {
 void backlight_set(uint8_t level) {
     if (level > BACKLIGHT_LEVELS) level = BACKLIGHT_LEVELS;
 
-    backlight_pins_off();
-
     backlight_timer_set_duty(cie_lightness(0xFFFFU / BACKLIGHT_LEVELS * level));
+    // stop the timer before the pins turn off, so a last cycle can not turn them back on
     backlight_timer_configure(level != 0);
+
+    backlight_pins_off();
 }
 
 static void backlight_timer_top(void) {
 #ifdef BACKLIGHT_BREATHING
-    if (is_breathing()) {
+    static uint16_t breathing_cycles = 0;
+    if (is_breathing() && ++breathing_cycles >= BREATHING_CYCLES) {
+        breathing_cycles = 0;
         breathing_task();
     }
 #endif
@@ -107,50 +122,46 @@ void breathing_pulse(void) {
 #endif
 
 #ifdef PROTOCOL_CHIBIOS
-// On Platforms where timers fire every tick and have no capture/top events
-//   - fake event in the normal timer callback
-uint16_t s_duty = 0;
-
-static void timerCallback(void) {
-    /* Software PWM
-     * timer:1111 1111 1111 1111
-     *       \______/| \_______/____  count(0-255)
-     *          \    \______________  unused(1)
-     *           \__________________  index of step table(0-127)
-     */
-
-    // this works for cca 65536 irqs/sec
-    static union {
-        uint16_t raw;
-        struct {
-            uint16_t count : 8;
-            uint8_t  dummy : 1;
-            uint8_t  index : 7;
-        } pwm;
-    } timer = {.raw = 0};
-
-    timer.raw++;
-
-    if (timer.pwm.count == 0) {
-        // LED on
-        backlight_timer_top();
-    } else if (timer.pwm.count == (s_duty / 256)) {
-        // LED off
-        backlight_timer_cmp();
-    }
+// Software PWM from a one-shot timer: instead of counting every tick, the timer
+// fires once at the start of each PWM cycle and once when the pins turn off, so
+// the PWM frequency does not depend on the main loop or on the interrupt load.
+static uint16_t          s_duty         = 0;
+static volatile gptcnt_t s_on_ticks     = 0;
+static bool              s_running      = false;
+static bool              s_compare_next = false;
+
+static void backlight_timer_set_duty(uint16_t duty) {
+    s_duty     = duty;
+    s_on_ticks = ((uint32_t)duty * BACKLIGHT_PWM_PERIOD + 0x8000) >> 16;
 }
-
-static void     backlight_timer_set_duty(uint16_t duty) { s_duty = duty; }
 static uint16_t backlight_timer_get_duty(void) { return s_duty; }
 
-// ChibiOS - Map GPT timer onto Software PWM
 static void gptTimerCallback(GPTDriver *gptp) {
-    (void)gptp;
-    timerCallback();
+    static gptcnt_t on_ticks = 0;
+    gptcnt_t        interval = BACKLIGHT_PWM_PERIOD;
+
+    if (s_compare_next) {
+        // LED off, until the end of the cycle
+        backlight_timer_cmp();
+        interval       = BACKLIGHT_PWM_PERIOD - on_ticks;
+        s_compare_next = false;
+    } else {
+        // LED on, unless the whole cycle is off
+        backlight_timer_top();
+        on_ticks = s_on_ticks;
+        if (on_ticks > 0 && on_ticks < BACKLIGHT_PWM_PERIOD) {
+            interval       = on_ticks;
+            s_compare_next = true;
+        }
+    }
+
+    chSysLockFromISR();
+    gptStartOneShotI(gptp, interval);
+    chSysUnlockFromISR();
 }
 
 static void backlight_timer_configure(bool enable) {
-    static const GPTConfig gptcfg = {1000000, gptTimerCallback, 0, 0};
+    static const GPTConfig gptcfg = {BACKLIGHT_TIMER_FREQUENCY, gptTimerCallback, 0, 0};
 
     static bool s_init = false;
     if (!s_init) {
@@ -158,10 +169,15 @@ static void backlight_timer_configure(bool enable) {
         s_init = true;
     }
 
-    if (enable) {
-        gptStartContinuous(&BACKLIGHT_GPT_DRIVER, gptcfg.frequency / 0xFFFF);
-    } else {
+    if (enable && !s_running) {
+        // the timer was stopped at any point of a cycle, start a new one
+        s_compare_next = false;
+        gptStartOneShot(&BACKLIGHT_GPT_DRIVER, BACKLIGHT_PWM_PERIOD);
+    } else if (!enable && s_running) {
         gptStopTimer(&BACKLIGHT_GPT_DRIVER);
     }
+    s_running = enable;
 }
+#else
+#    error "The timer backlight driver is only available on ChibiOS. On AVR, the pwm driver already uses timer assisted PWM on any pin."
 #endif
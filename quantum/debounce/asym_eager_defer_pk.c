@@ -0,0 +1,158 @@
+/*
+Copyright 2021 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Asymmetric per-key algorithm. Uses an 8-bit counter per key.
+Key-down is eager: a press is pushed on its first edge, then further inputs on that key
+are ignored for DEBOUNCE_PRESS milliseconds.
+Key-up is deferred: a release is only pushed once the key has read released for
+DEBOUNCE_RELEASE milliseconds without interruption, which filters release chatter.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+#ifndef DEBOUNCE_PRESS
+#    define DEBOUNCE_PRESS DEBOUNCE
+#endif
+
+#ifndef DEBOUNCE_RELEASE
+#    define DEBOUNCE_RELEASE DEBOUNCE
+#endif
+
+#if DEBOUNCE_PRESS > 127 || DEBOUNCE_RELEASE > 127
+#    error DEBOUNCE_PRESS and DEBOUNCE_RELEASE must be at most 127 for this debounce algorithm.
+#endif
+
+#define ROW_SHIFTER ((matrix_row_t)1)
+
+// time is the number of milliseconds left, 0 when no window is running.
+// pressed tells whether the window is the press lock or the release delay.
+typedef struct {
+    bool    pressed : 1;
+    uint8_t time : 7;
+} debounce_counter_t;
+
+static debounce_counter_t *debounce_counters;
+static bool                counters_need_update;
+static bool                matrix_need_update;
+static uint16_t            last_time;
+
+void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_counters = (debounce_counter_t *)malloc(num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
+    int i             = 0;
+    for (uint8_t r = 0; r < num_rows; r++) {
+        for (uint8_t c = 0; c < MATRIX_COLS; c++) {
+            debounce_counters[i].pressed = false;
+            debounce_counters[i].time    = 0;
+            i++;
+        }
+    }
+    last_time = timer_read();
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    uint16_t elapsed_time = timer_elapsed(last_time);
+    last_time += elapsed_time;
+
+    if (counters_need_update && elapsed_time) {
+        update_debounce_counters(raw, cooked, num_rows, elapsed_time > 127 ? 127 : elapsed_time);
+    }
+
+    if (changed || matrix_need_update) {
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+}
+
+// Count down the running windows, push the releases whose delay has run out.
+void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update                 = false;
+    debounce_counter_t *debounce_pointer = debounce_counters;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (debounce_pointer->time) {
+                if (debounce_pointer->time <= elapsed_time) {
+                    debounce_pointer->time = 0;
+                    if (debounce_pointer->pressed) {
+                        // the press lock is over, look at the key again
+                        matrix_need_update = true;
+                    } else {
+                        cooked[row] &= ~(ROW_SHIFTER << col);
+                    }
+                } else {
+                    debounce_pointer->time -= elapsed_time;
+                    counters_need_update = true;
+                }
+            }
+            debounce_pointer++;
+        }
+    }
+}
+
+// upload from raw_matrix to final matrix;
+void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_need_update                   = false;
+    debounce_counter_t *debounce_pointer = debounce_counters;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta        = raw[row] ^ cooked[row];
+        matrix_row_t existing_row = cooked[row];
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t col_mask = (ROW_SHIFTER << col);
+            if (delta & col_mask) {
+                if (debounce_pointer->time == 0) {
+                    if (raw[row] & col_mask) {
+                        // press: push it now, then lock the key
+                        existing_row ^= col_mask;
+                        debounce_pointer->pressed = true;
+                        debounce_pointer->time    = DEBOUNCE_PRESS;
+                    } else if (DEBOUNCE_RELEASE == 0) {
+                        existing_row ^= col_mask;
+                    } else {
+                        // release: wait for it to settle
+                        debounce_pointer->pressed = false;
+                        debounce_pointer->time    = DEBOUNCE_RELEASE;
+                    }
+                    if (debounce_pointer->time) {
+                        counters_need_update = true;
+                    }
+                } else if (debounce_pointer->pressed) {
+                    matrix_need_update = true;
+                }
+            } else if (debounce_pointer->time && !debounce_pointer->pressed) {
+                // the key bounced back to pressed before the release settled
+                debounce_pointer->time = 0;
+            }
+            debounce_pointer++;
+        }
+        cooked[row] = existing_row;
+    }
+}
+
+bool debounce_active(void) { return true; }
@@ -0,0 +1,151 @@
+/*
+Copyright 2021 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Per-key algorithm using vertical counters. Behaves like sym_eager_pk:
+after pressing a key, it immediately changes state, and sets a counter.
+No further inputs are accepted on that key until DEBOUNCE milliseconds have occurred.
+Each bit of counters[row][n] is bit n of the counter of one key, so all keys of a row
+are counted down together with a handful of bitwise operations, and no heap is needed.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+#if DEBOUNCE > 0
+
+#    if DEBOUNCE > 255
+#        error DEBOUNCE must be at most 255 for this debounce algorithm.
+#    elif DEBOUNCE > 127
+#        define COUNTER_BITS 8
+#    elif DEBOUNCE > 63
+#        define COUNTER_BITS 7
+#    elif DEBOUNCE > 31
+#        define COUNTER_BITS 6
+#    elif DEBOUNCE > 15
+#        define COUNTER_BITS 5
+#    elif DEBOUNCE > 7
+#        define COUNTER_BITS 4
+#    elif DEBOUNCE > 3
+#        define COUNTER_BITS 3
+#    elif DEBOUNCE > 1
+#        define COUNTER_BITS 2
+#    else
+#        define COUNTER_BITS 1
+#    endif
+
+static matrix_row_t counters[MATRIX_ROWS][COUNTER_BITS];
+static bool         counters_need_update;
+static bool         matrix_need_update;
+static uint16_t     last_time;
+
+// Keys of the row with a running counter.
+static matrix_row_t counters_active(const matrix_row_t *counter) {
+    matrix_row_t active = 0;
+    for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+        active |= counter[bit];
+    }
+    return active;
+}
+
+// Decrement all running counters of a row by one, returns the keys that reached zero.
+static matrix_row_t counters_tick(matrix_row_t *counter) {
+    matrix_row_t active = counters_active(counter);
+    matrix_row_t borrow = active;
+    for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+        matrix_row_t value = counter[bit];
+        counter[bit]       = value ^ borrow;
+        borrow &= ~value;
+    }
+    return active & ~counters_active(counter);
+}
+
+// Load DEBOUNCE into the counters of the keys in mask, clear those not in keep.
+static void counters_restart(matrix_row_t *counter, matrix_row_t mask, matrix_row_t keep) {
+    for (uint8_t bit = 0; bit < COUNTER_BITS; bit++) {
+        counter[bit] &= keep;
+        if (DEBOUNCE & (1 << bit)) {
+            counter[bit] |= mask;
+        }
+    }
+}
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        counters_restart(counters[row], 0, 0);
+    }
+    counters_need_update = false;
+    matrix_need_update   = false;
+    last_time            = timer_read();
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    uint16_t elapsed = timer_elapsed(last_time);
+    last_time += elapsed;
+
+    if (counters_need_update && elapsed) {
+        if (elapsed > DEBOUNCE) {
+            elapsed = DEBOUNCE;
+        }
+        counters_need_update = false;
+        for (uint8_t row = 0; row < num_rows; row++) {
+            for (uint16_t i = 0; i < elapsed; i++) {
+                counters_tick(counters[row]);
+            }
+            if (counters_active(counters[row])) {
+                counters_need_update = true;
+            }
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        matrix_need_update = false;
+        for (uint8_t row = 0; row < num_rows; row++) {
+            matrix_row_t delta  = raw[row] ^ cooked[row];
+            matrix_row_t active = counters_active(counters[row]);
+            matrix_row_t flip   = delta & ~active;
+            if (flip) {
+                cooked[row] ^= flip;
+                counters_restart(counters[row], flip, active);
+                counters_need_update = true;
+            }
+            // changes on locked keys are picked up once their counter runs out
+            if (delta & active) {
+                matrix_need_update = true;
+            }
+        }
+    }
+}
+
+#else
+
+void debounce_init(uint8_t num_rows) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    if (changed) {
+        for (uint8_t row = 0; row < num_rows; row++) {
+            cooked[row] = raw[row];
+        }
+    }
+}
+
+#endif
+
+bool debounce_active(void) { return true; }
@@ -0,0 +1,166 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "matrix.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_init(uint8_t num_rows);
+void reference_debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void reference_debounce_init(uint8_t num_rows);
+}
+
+typedef void (*debounce_fn_t)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+
+// Level of a single key from a given time (ms) onwards
+struct Edge {
+    uint32_t time;
+    bool     pressed;
+};
+
+// Debounced level changes of the key
+struct Event {
+    uint32_t time;
+    bool     pressed;
+};
+
+/* Plays a single key trace through a debounce algorithm, scanning every millisecond. */
+class AsymEagerDeferPk : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        debounce_init(MATRIX_ROWS);
+        reference_debounce_init(MATRIX_ROWS);
+    }
+
+    std::vector<Event> play(debounce_fn_t fn, const std::vector<Edge>& trace, uint32_t duration) {
+        matrix_row_t       raw[MATRIX_ROWS]    = {0};
+        matrix_row_t       cooked[MATRIX_ROWS] = {0};
+        std::vector<Event> events;
+        size_t             next = 0;
+
+        set_time(0);
+        for (uint32_t t = 0; t < duration; t++, advance_time(1)) {
+            bool changed = false;
+            while (next < trace.size() && trace[next].time <= t) {
+                matrix_row_t level = trace[next].pressed ? 1 : 0;
+                changed |= (raw[2] & 1) != level;
+                raw[2] = (raw[2] & ~1) | level;
+                next++;
+            }
+            matrix_row_t before = cooked[2];
+            fn(raw, cooked, MATRIX_ROWS, changed);
+            if (cooked[2] != before) {
+                events.push_back({t, (bool)(cooked[2] & 1)});
+            }
+        }
+        return events;
+    }
+
+    uint32_t seed = 1;
+
+    uint32_t random(uint32_t range) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % range;
+    }
+
+    // A keystroke with up to `bounces` contact bounces on each edge
+    std::vector<Edge> bouncing_keystroke(uint32_t press, uint32_t release, uint32_t bounces) {
+        std::vector<Edge> trace;
+        uint32_t          t = press;
+        for (uint32_t i = random(bounces + 1); i > 0; i--) {
+            trace.push_back({t, true});
+            t += 1 + random(2);
+            trace.push_back({t, false});
+            t += 1 + random(2);
+        }
+        trace.push_back({t, true});
+        t = release;
+        for (uint32_t i = random(bounces + 1); i > 0; i--) {
+            trace.push_back({t, false});
+            t += 1 + random(2);
+            trace.push_back({t, true});
+            t += 1 + random(2);
+        }
+        trace.push_back({t, false});
+        return trace;
+    }
+};
+
+TEST_F(AsymEagerDeferPk, CleanKeystroke) {
+    auto events = play(debounce, {{10, true}, {50, false}}, 100);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].time, 10);
+    EXPECT_TRUE(events[0].pressed);
+    EXPECT_EQ(events[1].time, 50 + DEBOUNCE_RELEASE);
+    EXPECT_FALSE(events[1].pressed);
+}
+
+TEST_F(AsymEagerDeferPk, PressBounceIsIgnored) {
+    auto events = play(debounce, {{10, true}, {11, false}, {12, true}, {13, false}, {14, true}, {50, false}}, 100);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].time, 10);
+    EXPECT_EQ(events[1].time, 50 + DEBOUNCE_RELEASE);
+}
+
+TEST_F(AsymEagerDeferPk, ReleaseChatterIsFiltered) {
+    // Released for less than DEBOUNCE_RELEASE several times before the final release
+    auto events = play(debounce, {{10, true}, {40, false}, {42, true}, {43, false}, {45, true}, {60, false}}, 100);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].time, 10);
+    EXPECT_EQ(events[1].time, 60 + DEBOUNCE_RELEASE);
+}
+
+TEST_F(AsymEagerDeferPk, ReleaseDuringPressLock) {
+    // Released before the press lock is over: pushed after the lock and the release delay
+    auto events = play(debounce, {{10, true}, {12, false}}, 100);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].time, 10);
+    EXPECT_EQ(events[1].time, 10 + DEBOUNCE_PRESS + DEBOUNCE_RELEASE);
+}
+
+TEST_F(AsymEagerDeferPk, PressLatency) {
+    uint32_t asym_latency      = 0;
+    uint32_t reference_latency = 0;
+    uint32_t keystrokes        = 1000;
+
+    for (uint32_t i = 0; i < keystrokes; i++) {
+        auto trace     = bouncing_keystroke(10, 60, 3);
+        auto events    = play(debounce, trace, 120);
+        auto reference = play(reference_debounce, trace, 120);
+
+        // exactly one press and one release, however much the contacts bounce
+        ASSERT_EQ(events.size(), 2) << "keystroke " << i;
+        EXPECT_TRUE(events[0].pressed);
+        EXPECT_FALSE(events[1].pressed);
+        EXPECT_EQ(events[0].time, 10);
+        ASSERT_EQ(reference.size(), 2) << "keystroke " << i;
+
+        asym_latency += events[0].time - 10;
+        reference_latency += reference[0].time - 10;
+    }
+
+    EXPECT_EQ(asym_latency, 0);
+    printf("mean added press latency over %u bouncing keystrokes: %.2f ms, sym_defer_pk %.2f ms\n", keystrokes, (double)asym_latency / keystrokes, (double)reference_latency / keystrokes);
+}
@@ -0,0 +1,102 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <string.h>
+
+extern "C" {
+#include "matrix.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_init(uint8_t num_rows);
+void reference_debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void reference_debounce_init(uint8_t num_rows);
+}
+
+typedef void (*debounce_fn_t)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+
+/* Synthetic matrix traces with chattering keys, fed to the algorithm under test and to the reference one in lockstep. */
+class DebounceEquivalence : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        memset(raw, 0, sizeof(raw));
+        memset(cooked, 0, sizeof(cooked));
+        memset(reference_cooked, 0, sizeof(reference_cooked));
+        seed = 1;
+        debounce_init(MATRIX_ROWS);
+        reference_debounce_init(MATRIX_ROWS);
+    }
+
+    uint32_t random(uint32_t range) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 8) % range;
+    }
+
+    // One scan: maybe advance the clock, maybe bounce a few keys.
+    bool step(uint32_t change_chance) {
+        advance_time(random(3));
+        bool changed = false;
+        if (random(100) < change_chance) {
+            for (uint32_t i = random(4); i > 0; i--) {
+                raw[random(MATRIX_ROWS)] ^= (matrix_row_t)1 << random(MATRIX_COLS);
+            }
+            changed = true;
+        }
+        return changed;
+    }
+
+    void run_equivalence(uint32_t scans, uint32_t change_chance) {
+        for (uint32_t i = 0; i < scans; i++) {
+            bool changed = step(change_chance);
+            debounce(raw, cooked, MATRIX_ROWS, changed);
+            reference_debounce(raw, reference_cooked, MATRIX_ROWS, changed);
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                ASSERT_EQ(cooked[row], reference_cooked[row]) << "scan " << i << ", row " << (int)row;
+            }
+        }
+    }
+
+    int64_t benchmark(debounce_fn_t fn, uint32_t scans, uint32_t change_chance) {
+        set_time(0);
+        seed = 1;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < scans; i++) {
+            bool changed = step(change_chance);
+            fn(raw, cooked, MATRIX_ROWS, changed);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void run_benchmark(uint32_t change_chance) {
+        const uint32_t scans     = 1000000;
+        int64_t        vc        = benchmark(debounce, scans, change_chance);
+        int64_t        reference = benchmark(reference_debounce, scans, change_chance);
+        printf("%u scans, %u%% changing: %lld us, reference %lld us\n", scans, change_chance, (long long)vc, (long long)reference);
+    }
+
+    matrix_row_t raw[MATRIX_ROWS];
+    matrix_row_t cooked[MATRIX_ROWS];
+    matrix_row_t reference_cooked[MATRIX_ROWS];
+    uint32_t     seed;
+};
@@ -0,0 +1,25 @@
+DEBOUNCE_TEST_DEFS := -DNO_DEBUG -DMATRIX_ROWS=8 -DMATRIX_COLS=16 -DDEBOUNCE=5
+
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_TEST_DEFS)
+
+debounce_sym_defer_vc_SRC := \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_vc_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_reference.c \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(TMK_PATH)/common/test/timer.c
+
+debounce_sym_eager_vc_DEFS := $(DEBOUNCE_TEST_DEFS)
+
+debounce_sym_eager_vc_SRC := \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_vc_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_reference.c \
+	$(QUANTUM_PATH)/debounce/sym_eager_vc.c \
+	$(TMK_PATH)/common/test/timer.c
+
+debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_TEST_DEFS) -DDEBOUNCE_PRESS=10 -DDEBOUNCE_RELEASE=5
+
+debounce_asym_eager_defer_pk_SRC := \
+	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_reference.c \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
+	$(TMK_PATH)/common/test/timer.c
@@ -0,0 +1,29 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "debounce_equivalence.hpp"
+
+// reference_debounce is sym_defer_pk
+
+TEST_F(DebounceEquivalence, QuietMatrix) { run_equivalence(100000, 1); }
+
+TEST_F(DebounceEquivalence, ChatteringMatrix) { run_equivalence(100000, 50); }
+
+TEST_F(DebounceEquivalence, ConstantChanges) { run_equivalence(100000, 100); }
+
+TEST_F(DebounceEquivalence, BenchmarkQuiet) { run_benchmark(1); }
+
+TEST_F(DebounceEquivalence, BenchmarkChattering) { run_benchmark(50); }
@@ -0,0 +1,4 @@
+TEST_LIST +=\
+	debounce_sym_defer_vc\
+	debounce_sym_eager_vc\
+	debounce_asym_eager_defer_pk
@@ -21,6 +21,7 @@
 #include "quantum.h"  // for send_string()
 #include "dynamic_keymap.h"
 #include "via.h"  // for default VIA_EEPROM_ADDR_END
+#include <string.h>
 
 #ifndef DYNAMIC_KEYMAP_LAYER_COUNT
 #    define DYNAMIC_KEYMAP_LAYER_COUNT 4
@@ -73,6 +74,11 @@
 #    error Dynamic keymaps are configured to use more EEPROM than is available.
 #endif
 
+// Number of bytes read from EEPROM at a time when indexing or sending macros
+#ifndef DYNAMIC_KEYMAP_MACRO_BLOCK_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_BLOCK_SIZE 32
+#endif
+
 // Dynamic macros are stored after the keymaps and use what is available
 // up to and including DYNAMIC_KEYMAP_EEPROM_MAX_ADDR.
 #ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE
@@ -99,6 +105,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_LAYER_INDICATORS)
+    rgb_matrix_layer_indicators_refresh();
+#endif
 }
 
 void dynamic_keymap_reset(void) {
@@ -112,34 +121,36 @@ void dynamic_keymap_reset(void) {
             }
         }
     }
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_LAYER_INDICATORS)
+    rgb_matrix_layer_indicators_refresh();
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
+    uint16_t count                      = 0;
+    if (offset < dynamic_keymap_eeprom_size) {
+        count = dynamic_keymap_eeprom_size - offset;
+        if (count > size) {
+            count = size;
         }
-        source++;
-        target++;
+        eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), count);
     }
+    memset(data + count, 0x00, size - count);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+    if (offset < dynamic_keymap_eeprom_size) {
+        uint16_t count = dynamic_keymap_eeprom_size - offset;
+        if (count > size) {
+            count = size;
         }
-        source++;
-        target++;
+        eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), count);
     }
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_LAYER_INDICATORS)
+    rgb_matrix_layer_indicators_refresh();
+#endif
 }
 
 // This overrides the one in quantum/keymap_common.c
@@ -156,28 +167,73 @@ uint8_t dynamic_keymap_macro_get_count(void) { return DYNAMIC_KEYMAP_MACRO_COUNT
 uint16_t dynamic_keymap_macro_get_buffer_size(void) { return DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
+    uint16_t count = 0;
+    if (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        count = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset;
+        if (count > size) {
+            count = size;
+        }
+        eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), count);
+    }
+    memset(data + count, 0x00, size - count);
+}
+
+// Offset of each macro in the macro buffer, so sending a macro does not have to scan the EEPROM
+// for it. Rebuilt after the buffer changes. Macros past the end of the buffer contents (i.e.
+// there were not DYNAMIC_KEYMAP_MACRO_COUNT nulls in the buffer, or the buffer is in the middle
+// of being written) get DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE.
+static uint16_t macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     macro_offsets_valid = false;
+
+static void dynamic_keymap_macro_update_offsets(void) {
+    uint8_t  block[DYNAMIC_KEYMAP_MACRO_BLOCK_SIZE];
+    uint8_t  id     = 0;
+    uint16_t offset = 0;
+
+    // Check the last byte of the buffer.
+    // If it's not zero, then we are in the middle
+    // of buffer writing, possibly an aborted buffer
+    // write. So do not index any macros.
+    if (eeprom_read_byte((void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1)) == 0) {
+        macro_offsets[id++] = 0;
+    }
+
+    while (id > 0 && id < DYNAMIC_KEYMAP_MACRO_COUNT && offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        uint16_t size = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset;
+        if (size > sizeof(block)) {
+            size = sizeof(block);
         }
-        source++;
-        target++;
+        eeprom_read_block(block, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), size);
+        for (uint16_t i = 0; i < size && id < DYNAMIC_KEYMAP_MACRO_COUNT; i++) {
+            if (block[i] == 0) {
+                macro_offsets[id++] = offset + i + 1;
+            }
+        }
+        offset += size;
+    }
+
+    while (id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        macro_offsets[id++] = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
     }
+    macro_offsets_valid = true;
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+    if (offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        uint16_t count = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset;
+        if (count > size) {
+            count = size;
         }
-        source++;
-        target++;
+        eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), count);
+    }
+
+    // Hosts write the last byte of the buffer before and after a transfer (see dynamic_keymap.h),
+    // so only those writes rebuild the offsets straight away, the ones in between are left to
+    // the next macro sent.
+    if (offset + size >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        dynamic_keymap_macro_update_offsets();
+    } else {
+        macro_offsets_valid = false;
     }
 }
 
@@ -188,61 +244,96 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+    dynamic_keymap_macro_update_offsets();
 }
 
-void dynamic_keymap_macro_send(uint8_t id) {
-    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
-        return;
-    }
+typedef struct {
+    uint16_t offset;  // of the next block to read
+    uint8_t  index;   // of the next byte in the block
+    uint8_t  size;    // of the block
+    uint8_t  code;    // SS_*_CODE waiting to be returned after SS_QMK_PREFIX
+    uint8_t  state;
+    uint8_t  block[DYNAMIC_KEYMAP_MACRO_BLOCK_SIZE];
+} dynamic_keymap_macro_reader_t;
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
-        return;
-    }
+enum {
+    MACRO_READ_CHAR,     // plain characters, or the start of a code
+    MACRO_READ_CODE,     // SS_QMK_PREFIX was returned, the code comes next
+    MACRO_READ_KEYCODE,  // the keycode after a tap, down or up code comes next
+    MACRO_READ_DELAY,    // the digits after a delay code, up to the first non-digit
+};
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then the buffer
-        // contents are garbage, i.e. there were not DYNAMIC_KEYMAP_MACRO_COUNT
-        // nulls in the buffer.
-        if (p == end) {
-            return;
+static uint8_t dynamic_keymap_macro_read_byte(dynamic_keymap_macro_reader_t *reader) {
+    if (reader->index == reader->size) {
+        // We checked there was a null at the end of the buffer, so this never needs to read past it
+        uint16_t size = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - reader->offset;
+        if (size > sizeof(reader->block)) {
+            size = sizeof(reader->block);
         }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
-        }
-        ++p;
+        eeprom_read_block(reader->block, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + reader->offset), size);
+        reader->offset += size;
+        reader->index = 0;
+        reader->size  = size;
+    }
+
+    uint8_t data = reader->block[reader->index];
+    if (data != 0) {
+        reader->index++;
     }
+    return data;
+}
+
+// Macros are stored with the tap, down, up and delay codes not prefixed by SS_QMK_PREFIX,
+// which is added back here so the send engine can consume the macro as it is read.
+static char dynamic_keymap_macro_get_next(void *arg) {
+    dynamic_keymap_macro_reader_t *reader = (dynamic_keymap_macro_reader_t *)arg;
 
-    // Send the macro string one or three chars at a time
-    // by making temporary 1 or 3 char strings
-    char data[4] = {0, 0, 0, 0};
-    // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
-        // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
-            break;
+    switch (reader->state) {
+        case MACRO_READ_CODE:
+            reader->state = reader->code == SS_DELAY_CODE ? MACRO_READ_DELAY : MACRO_READ_KEYCODE;
+            return reader->code;
+        case MACRO_READ_KEYCODE:
+            reader->state = MACRO_READ_CHAR;
+            return dynamic_keymap_macro_read_byte(reader);
+        case MACRO_READ_DELAY: {
+            uint8_t data = dynamic_keymap_macro_read_byte(reader);
+            if (data < '0' || data > '9') {
+                reader->state = MACRO_READ_CHAR;
+            }
+            return data;
         }
-        // If the char is magic (tap, down, up),
-        // add the next char (key to use) and send a 3 char string.
-        if (data[0] == SS_TAP_CODE || data[0] == SS_DOWN_CODE || data[0] == SS_UP_CODE) {
-            data[1] = data[0];
-            data[0] = SS_QMK_PREFIX;
-            data[2] = eeprom_read_byte(p++);
-            if (data[2] == 0) {
-                break;
+        default: {
+            uint8_t data = dynamic_keymap_macro_read_byte(reader);
+            if (data == SS_TAP_CODE || data == SS_DOWN_CODE || data == SS_UP_CODE || data == SS_DELAY_CODE) {
+                reader->code  = data;
+                reader->state = MACRO_READ_CODE;
+                return SS_QMK_PREFIX;
             }
+            return data;
         }
-        send_string(data);
     }
 }
+
+void dynamic_keymap_macro_send(uint8_t id) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
+        return;
+    }
+
+    if (!macro_offsets_valid) {
+        dynamic_keymap_macro_update_offsets();
+    }
+
+    // The buffer is being written, or does not hold this many macros
+    if (macro_offsets[id] >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        return;
+    }
+
+    // Stream the macro into the send engine a block at a time
+    dynamic_keymap_macro_reader_t reader = {
+        .offset = macro_offsets[id],
+        .index  = 0,
+        .size   = 0,
+        .state  = MACRO_READ_CHAR,
+    };
+    send_string_with_delay_impl(dynamic_keymap_macro_get_next, &reader, 0);
+}
@@ -50,6 +50,11 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 // strings, the last byte must be a null when at maximum capacity,
 // and it not being null means the buffer can be considered in an
 // invalid state.
+//
+// Within a macro, the bytes SS_TAP_CODE, SS_DOWN_CODE and SS_UP_CODE are followed by
+// the keycode to tap, press or release, and SS_DELAY_CODE is followed by the delay in
+// milliseconds as decimal digits and a '|'. Unlike SEND_STRING(), these are not prefixed
+// by SS_QMK_PREFIX. UTF-8 characters are sent with unicode input if it is enabled.
 
 uint8_t  dynamic_keymap_macro_get_count(void);
 uint16_t dynamic_keymap_macro_get_buffer_size(void);
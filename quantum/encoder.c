@@ -16,13 +16,11 @@
  */
 
 #include "encoder.h"
+#include "encoder_queue.h"
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
 #endif
 
-// for memcpy
-#include <string.h>
-
 #if !defined(ENCODER_RESOLUTIONS) && !defined(ENCODER_RESOLUTION)
 #    define ENCODER_RESOLUTION 4
 #endif
@@ -45,24 +43,73 @@ static uint8_t encoder_resolutions[] = ENCODER_RESOLUTIONS;
 #    define ENCODER_CLOCKWISE false
 #    define ENCODER_COUNTER_CLOCKWISE true
 #endif
-static int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
 
-static uint8_t encoder_state[NUMBER_OF_ENCODERS]  = {0};
-static int8_t  encoder_pulses[NUMBER_OF_ENCODERS] = {0};
+static encoder_decoder_t encoder_decoders[NUMBER_OF_ENCODERS];
+#ifdef ENCODER_ACCELERATION
+static uint16_t encoder_last_step[NUMBER_OF_ENCODERS];
+static int8_t   encoder_last_direction[NUMBER_OF_ENCODERS];
+#endif
 
 #ifdef SPLIT_KEYBOARD
-// right half encoders come over as second set of encoders
-static uint8_t encoder_value[NUMBER_OF_ENCODERS * 2] = {0};
-// row offsets for each hand
-static uint8_t thisHand, thatHand;
-#else
-static uint8_t encoder_value[NUMBER_OF_ENCODERS] = {0};
+// row offsets for each hand, right half encoders come over as second set of encoders
+static uint8_t thisHand;
+// slave: the steps for the master, and how many of them the master has replayed
+static encoder_log_t encoder_log;
+static uint8_t       encoder_log_ack;
+// slave: the steps of an event that didn't fit in the log yet
+static encoder_event_t encoder_carry;
+// master: how many steps of the slave's log have been replayed
+static uint8_t encoder_log_tail;
 #endif
 
 __attribute__((weak)) void encoder_update_user(int8_t index, bool clockwise) {}
 
 __attribute__((weak)) void encoder_update_kb(int8_t index, bool clockwise) { encoder_update_user(index, clockwise); }
 
+static inline uint8_t encoder_pins(uint8_t i) { return (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1); }
+
+static void encoder_sample(uint16_t time) {
+    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
+#ifdef ENCODER_RESOLUTIONS
+        uint8_t resolution = encoder_resolutions[i];
+#else
+        uint8_t resolution = ENCODER_RESOLUTION;
+#endif
+        encoder_decoder_sample(&encoder_decoders[i], i, encoder_pins(i), resolution, time);
+    }
+}
+
+#ifdef ENCODER_TIMER_SAMPLING
+#    ifndef PROTOCOL_CHIBIOS
+#        error "ENCODER_TIMER_SAMPLING is only available on ChibiOS"
+#    endif
+#    ifndef ENCODER_SAMPLE_INTERVAL_US
+#        define ENCODER_SAMPLE_INTERVAL_US 500
+#    endif
+#    if ENCODER_SAMPLE_INTERVAL_US < 1 || ENCODER_SAMPLE_INTERVAL_US > 10000
+#        error "ENCODER_SAMPLE_INTERVAL_US must be between 1 and 10000"
+#    endif
+
+static virtual_timer_t encoder_timer;
+// Time of the samples, counted by the timer itself since timer_read() isn't safe from an interrupt
+static uint16_t encoder_sample_ms;
+static uint16_t encoder_sample_us;
+
+// called from ISR, unlocked state
+static void encoder_timer_cb(void *arg) {
+    encoder_sample_us += ENCODER_SAMPLE_INTERVAL_US;
+    while (encoder_sample_us >= 1000) {
+        encoder_sample_us -= 1000;
+        encoder_sample_ms++;
+    }
+    encoder_sample(encoder_sample_ms);
+
+    chSysLockFromISR();
+    chVTSetI(&encoder_timer, TIME_US2I(ENCODER_SAMPLE_INTERVAL_US), encoder_timer_cb, NULL);
+    chSysUnlockFromISR();
+}
+#endif
+
 void encoder_init(void) {
 #if defined(SPLIT_KEYBOARD) && defined(ENCODERS_PAD_A_RIGHT) && defined(ENCODERS_PAD_B_RIGHT)
     if (!isLeftHand) {
@@ -85,49 +132,83 @@ void encoder_init(void) {
         setPinInputHigh(encoders_pad_a[i]);
         setPinInputHigh(encoders_pad_b[i]);
 
-        encoder_state[i] = (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
+        encoder_decoder_init(&encoder_decoders[i], encoder_pins(i));
     }
 
 #ifdef SPLIT_KEYBOARD
     thisHand = isLeftHand ? 0 : NUMBER_OF_ENCODERS;
-    thatHand = NUMBER_OF_ENCODERS - thisHand;
 #endif
-}
 
-static bool encoder_update(int8_t index, uint8_t state) {
-    bool    changed = false;
-    uint8_t i       = index;
+#ifdef ENCODER_TIMER_SAMPLING
+    chVTObjectInit(&encoder_timer);
+    chVTSet(&encoder_timer, TIME_US2I(ENCODER_SAMPLE_INTERVAL_US), encoder_timer_cb, NULL);
+#endif
+}
 
-#ifdef ENCODER_RESOLUTIONS
-    int8_t resolution = encoder_resolutions[i];
-#else
-    int8_t resolution = ENCODER_RESOLUTION;
+#ifdef ENCODER_ACCELERATION
+static void encoder_accelerate(encoder_event_t *event) {
+    uint8_t i         = event->index;
+    int8_t  direction = event->steps > 0 ? 1 : -1;
+    if (direction == encoder_last_direction[i]) {
+        int16_t steps = event->steps * encoder_acceleration(TIMER_DIFF_16(event->time, encoder_last_step[i]));
+        event->steps  = steps > INT8_MAX ? INT8_MAX : steps < -INT8_MAX ? -INT8_MAX : steps;
+    }
+    encoder_last_direction[i] = direction;
+    encoder_last_step[i]      = event->time;
+}
 #endif
 
+/**
+ * Takes the steps of an event one at a time.
+ *
+ * @return false if a slave's log filled up, with the steps left in the event
+ */
+static bool encoder_update(encoder_event_t *event) {
+    uint8_t index = event->index;
 #ifdef SPLIT_KEYBOARD
     index += thisHand;
 #endif
-    encoder_pulses[i] += encoder_LUT[state & 0xF];
-    if (encoder_pulses[i] >= resolution) {
-        encoder_value[index]++;
-        changed = true;
-        encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
-    }
-    if (encoder_pulses[i] <= -resolution) {  // direction is arbitrary here, but this clockwise
-        encoder_value[index]--;
-        changed = true;
-        encoder_update_kb(index, ENCODER_CLOCKWISE);
+
+    while (event->steps != 0) {
+        // direction is arbitrary here, but negative is clockwise
+        bool clockwise = event->steps < 0 ? ENCODER_CLOCKWISE : ENCODER_COUNTER_CLOCKWISE;
+#ifdef SPLIT_KEYBOARD
+        if (!is_keyboard_master() && !encoder_log_push(&encoder_log, encoder_log_ack, index, clockwise)) {
+            return false;
+        }
+#endif
+        event->steps += event->steps < 0 ? 1 : -1;
+        encoder_update_kb(index, clockwise);
     }
-    encoder_pulses[i] %= resolution;
-    return changed;
+    return true;
 }
 
 bool encoder_read(void) {
+#ifndef ENCODER_TIMER_SAMPLING
+    encoder_sample(timer_read());
+#endif
+
     bool changed = false;
-    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
-        encoder_state[i] <<= 2;
-        encoder_state[i] |= (readPin(encoders_pad_a[i]) << 0) | (readPin(encoders_pad_b[i]) << 1);
-        changed |= encoder_update(i, encoder_state[i]);
+#ifdef SPLIT_KEYBOARD
+    // the steps held back for the master go first, to keep them in order
+    if (encoder_carry.steps != 0) {
+        changed = true;
+        if (!encoder_update(&encoder_carry)) return changed;
+    }
+#endif
+
+    encoder_event_t event;
+    while (encoder_queue_pop(&event)) {
+        changed = true;
+#ifdef ENCODER_ACCELERATION
+        encoder_accelerate(&event);
+#endif
+        if (!encoder_update(&event)) {
+#ifdef SPLIT_KEYBOARD
+            encoder_carry = event;
+#endif
+            break;
+        }
     }
     return changed;
 }
@@ -135,28 +216,28 @@ bool encoder_read(void) {
 #ifdef SPLIT_KEYBOARD
 void last_encoder_activity_trigger(void);
 
-void encoder_state_raw(uint8_t* slave_state) { memcpy(slave_state, &encoder_value[thisHand], sizeof(uint8_t) * NUMBER_OF_ENCODERS); }
+void encoder_state_raw(encoder_log_t *slave_state, uint8_t master_ack) {
+    encoder_log_ack = master_ack;
 
-void encoder_update_raw(uint8_t* slave_state) {
-    bool changed = false;
-    for (uint8_t i = 0; i < NUMBER_OF_ENCODERS; i++) {
-        uint8_t index = i + thatHand;
-        int8_t  delta = slave_state[i] - encoder_value[index];
-        while (delta > 0) {
-            delta--;
-            encoder_value[index]++;
-            changed = true;
-            encoder_update_kb(index, ENCODER_COUNTER_CLOCKWISE);
-        }
-        while (delta < 0) {
-            delta++;
-            encoder_value[index]--;
-            changed = true;
-            encoder_update_kb(index, ENCODER_CLOCKWISE);
-        }
+    // steps before head, see encoder_log.h
+    for (uint8_t i = 0; i < ENCODER_LOG_SIZE; i++) {
+        slave_state->steps[i] = encoder_log.steps[i];
+    }
+    __asm__ __volatile__("" ::: "memory");
+    slave_state->head = encoder_log.head;
+}
+
+uint8_t encoder_update_raw(const encoder_log_t *slave_state) {
+    bool    changed = false;
+    uint8_t index;
+    bool    clockwise;
+    while (encoder_log_pop(slave_state, &encoder_log_tail, &index, &clockwise)) {
+        changed = true;
+        encoder_update_kb(index, clockwise);
     }
 
     // Update the last encoder input time -- handled external to encoder_read() when we're running a split
     if (changed) last_encoder_activity_trigger();
+    return encoder_log_tail;
 }
 #endif
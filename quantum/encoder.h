@@ -26,6 +26,19 @@ void encoder_update_kb(int8_t index, bool clockwise);
 void encoder_update_user(int8_t index, bool clockwise);
 
 #ifdef SPLIT_KEYBOARD
-void encoder_state_raw(uint8_t* slave_state);
-void encoder_update_raw(uint8_t* slave_state);
+#    include "encoder_log.h"
+
+/**
+ * Copies the slave's log of steps for the transport.
+ *
+ * @param master_ack the value the master's encoder_update_raw() returned last
+ */
+void encoder_state_raw(encoder_log_t* slave_state, uint8_t master_ack);
+
+/**
+ * Replays the steps of the slave's log the master hasn't seen yet.
+ *
+ * @return the acknowledgement the transport sends back to the slave
+ */
+uint8_t encoder_update_raw(const encoder_log_t* slave_state);
 #endif
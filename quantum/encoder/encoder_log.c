@@ -0,0 +1,46 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "encoder_log.h"
+
+#define LOG_MASK (ENCODER_LOG_SIZE - 1)
+
+bool encoder_log_push(encoder_log_t *log, uint8_t ack, uint8_t index, bool clockwise) {
+    uint8_t head = log->head;
+    if ((uint8_t)(head - ack) >= ENCODER_LOG_SIZE) return false;
+
+    log->steps[head & LOG_MASK] = (index & ENCODER_LOG_INDEX_MASK) | (clockwise ? ENCODER_LOG_CLOCKWISE : 0);
+    // the step has to be in place before the master can see it
+    __asm__ __volatile__("" ::: "memory");
+    log->head = head + 1;
+    return true;
+}
+
+bool encoder_log_pop(const encoder_log_t *log, uint8_t *tail, uint8_t *index, bool *clockwise) {
+    uint8_t head    = log->head;
+    uint8_t pending = head - *tail;
+    if (pending == 0) return false;
+    if (pending > ENCODER_LOG_SIZE) {
+        *tail = head;
+        return false;
+    }
+
+    uint8_t step = log->steps[*tail & LOG_MASK];
+    *index       = step & ENCODER_LOG_INDEX_MASK;
+    *clockwise   = step & ENCODER_LOG_CLOCKWISE;
+    (*tail)++;
+    return true;
+}
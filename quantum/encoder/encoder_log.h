@@ -0,0 +1,66 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * The steps of the slave half's encoders, on their way to the master. The
+ * slave logs every step in order, and the master replays the ones it hasn't
+ * seen yet each time it reads the log. The master acknowledges the steps it
+ * replayed, so the slave never overwrites a step the master hasn't read:
+ * however long the master takes, no step is lost or reordered.
+ *
+ * A torn read of the log, as it is being updated, is harmless as long as the
+ * slave writes the steps before the head, and the master reads the head
+ * before the steps, which is the order of the struct.
+ */
+
+#ifndef ENCODER_LOG_SIZE
+#    define ENCODER_LOG_SIZE 8
+#endif
+#if ENCODER_LOG_SIZE < 2 || ENCODER_LOG_SIZE > 128 || (ENCODER_LOG_SIZE & (ENCODER_LOG_SIZE - 1)) != 0
+#    error "ENCODER_LOG_SIZE must be a power of two between 2 and 128"
+#endif
+
+#define ENCODER_LOG_CLOCKWISE 0x80
+#define ENCODER_LOG_INDEX_MASK 0x7F
+
+typedef struct {
+    uint8_t head;                     // number of steps logged, wrapping around
+    uint8_t steps[ENCODER_LOG_SIZE];  // the encoder index, with ENCODER_LOG_CLOCKWISE set for clockwise steps
+} encoder_log_t;
+
+/**
+ * Logs a step, on the slave.
+ *
+ * @param ack the number of steps the master has replayed, as returned by encoder_log_pop()
+ * @return false if the log is full of steps the master hasn't replayed yet
+ */
+bool encoder_log_push(encoder_log_t *log, uint8_t ack, uint8_t index, bool clockwise);
+
+/**
+ * Takes the next step the master hasn't replayed yet.
+ *
+ * A log too far ahead of, or behind, the master's tail means one of the halves
+ * restarted, and the master starts over from the slave's head.
+ *
+ * @param tail the number of steps replayed so far, which the master sends back to the slave
+ * @return false if there is no step left to replay
+ */
+bool encoder_log_pop(const encoder_log_t *log, uint8_t *tail, uint8_t *index, bool *clockwise);
@@ -0,0 +1,89 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "encoder_queue.h"
+
+#define QUEUE_MASK (ENCODER_QUEUE_SIZE - 1)
+
+static const int8_t encoder_LUT[] = {0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0};
+
+// Written by the producer only
+static volatile uint8_t queue_head = 0;
+// Written by the consumer only
+static volatile uint8_t         queue_tail = 0;
+static volatile encoder_event_t queue[ENCODER_QUEUE_SIZE];
+
+static bool queue_push(uint8_t index, int8_t steps, uint16_t time) {
+    uint8_t head = queue_head;
+    if (((head + 1) & QUEUE_MASK) == queue_tail) return false;
+
+    queue[head].index = index;
+    queue[head].steps = steps;
+    queue[head].time  = time;
+    // the event has to be complete before the consumer can see it
+    __asm__ __volatile__("" ::: "memory");
+    queue_head = (head + 1) & QUEUE_MASK;
+    return true;
+}
+
+bool encoder_queue_pop(encoder_event_t *event) {
+    uint8_t tail = queue_tail;
+    if (tail == queue_head) return false;
+
+    event->index = queue[tail].index;
+    event->steps = queue[tail].steps;
+    event->time  = queue[tail].time;
+    __asm__ __volatile__("" ::: "memory");
+    queue_tail = (tail + 1) & QUEUE_MASK;
+    return true;
+}
+
+void encoder_queue_clear(void) { queue_tail = queue_head; }
+
+void encoder_decoder_init(encoder_decoder_t *decoder, uint8_t pins) {
+    decoder->state   = pins & 0x3;
+    decoder->pulses  = 0;
+    decoder->pending = 0;
+}
+
+int8_t encoder_decoder_sample(encoder_decoder_t *decoder, uint8_t index, uint8_t pins, uint8_t resolution, uint16_t time) {
+    int8_t steps = 0;
+
+    decoder->state = (decoder->state << 2) | (pins & 0x3);
+    decoder->pulses += encoder_LUT[decoder->state & 0xF];
+    if (decoder->pulses >= (int8_t)resolution) {
+        steps = 1;
+    }
+    if (decoder->pulses <= -(int8_t)resolution) {
+        steps = -1;
+    }
+    decoder->pulses %= (int8_t)resolution;
+
+    // Steps that didn't fit go out with the next one, rather than being lost
+    if ((steps > 0 && decoder->pending < INT8_MAX) || (steps < 0 && decoder->pending > INT8_MIN)) {
+        decoder->pending += steps;
+    }
+    if (decoder->pending != 0 && queue_push(index, decoder->pending, time)) {
+        decoder->pending = 0;
+    }
+    return steps;
+}
+
+uint8_t encoder_acceleration(uint16_t interval) {
+    if (interval >= ENCODER_ACCELERATION_INTERVAL) return 1;
+    if (interval <= ENCODER_ACCELERATION_INTERVAL / ENCODER_ACCELERATION_MAX) return ENCODER_ACCELERATION_MAX;
+    return ENCODER_ACCELERATION_INTERVAL / interval;
+}
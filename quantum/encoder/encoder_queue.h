@@ -0,0 +1,77 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Quadrature decoding, and the queue of steps between the code sampling the
+ * encoder pins and the main loop. The queue has a single producer, which may be
+ * an interrupt, and a single consumer, and needs no locking between them.
+ */
+
+#ifndef ENCODER_QUEUE_SIZE
+#    define ENCODER_QUEUE_SIZE 16
+#endif
+#if ENCODER_QUEUE_SIZE < 2 || ENCODER_QUEUE_SIZE > 128 || (ENCODER_QUEUE_SIZE & (ENCODER_QUEUE_SIZE - 1)) != 0
+#    error "ENCODER_QUEUE_SIZE must be a power of two between 2 and 128"
+#endif
+
+#ifndef ENCODER_ACCELERATION_INTERVAL
+#    define ENCODER_ACCELERATION_INTERVAL 60  // steps closer than this many milliseconds are accelerated
+#endif
+#ifndef ENCODER_ACCELERATION_MAX
+#    define ENCODER_ACCELERATION_MAX 4
+#endif
+
+typedef struct {
+    uint8_t  index;
+    int8_t   steps;  // positive is counter clockwise, before ENCODER_DIRECTION_FLIP
+    uint16_t time;   // in milliseconds, when the last of the steps was decoded
+} encoder_event_t;
+
+typedef struct {
+    uint8_t state;    // the last two readings of the pins, B1 A1 B0 A0
+    int8_t  pulses;   // transitions towards the next step
+    int8_t  pending;  // steps that didn't fit in the queue yet
+} encoder_decoder_t;
+
+void encoder_decoder_init(encoder_decoder_t *decoder, uint8_t pins);
+
+/**
+ * Decodes a reading of the pins of an encoder, and queues the steps it completes.
+ *
+ * @param pins the A pin in bit 0, the B pin in bit 1
+ * @param time in milliseconds
+ * @return the number of steps decoded
+ */
+int8_t encoder_decoder_sample(encoder_decoder_t *decoder, uint8_t index, uint8_t pins, uint8_t resolution, uint16_t time);
+
+/**
+ * Takes the oldest event of the queue.
+ *
+ * @return false if the queue is empty
+ */
+bool encoder_queue_pop(encoder_event_t *event);
+
+void encoder_queue_clear(void);
+
+/**
+ * @return how many steps a step should count for, given the milliseconds since the previous one in the same direction
+ */
+uint8_t encoder_acceleration(uint16_t interval);
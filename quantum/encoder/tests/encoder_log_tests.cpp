@@ -0,0 +1,173 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "encoder_log.h"
+}
+
+struct Step {
+    uint8_t index;
+    bool    clockwise;
+    bool    operator==(const Step &other) const { return index == other.index && clockwise == other.clockwise; }
+};
+
+class EncoderLog : public ::testing::Test {
+   protected:
+    // slave
+    encoder_log_t log = {};
+    uint8_t       ack = 0;
+    // master
+    encoder_log_t received = {};
+    uint8_t       tail     = 0;
+
+    std::vector<Step> sent, replayed;
+
+    bool step(uint8_t index, bool clockwise) {
+        if (!encoder_log_push(&log, ack, index, clockwise)) return false;
+        sent.push_back({index, clockwise});
+        return true;
+    }
+
+    // one transaction of the transport: the log to the master, and the acknowledgement back
+    void exchange() {
+        received = log;
+        Step step;
+        while (encoder_log_pop(&received, &tail, &step.index, &step.clockwise)) {
+            replayed.push_back(step);
+        }
+        ack = tail;
+    }
+};
+
+TEST_F(EncoderLog, ReplaysInOrder) {
+    ASSERT_TRUE(step(0, true));
+    ASSERT_TRUE(step(3, false));
+    ASSERT_TRUE(step(0, false));
+    exchange();
+    EXPECT_EQ(replayed, sent);
+    EXPECT_EQ(ack, 3);
+
+    // nothing new is nothing replayed
+    exchange();
+    EXPECT_EQ(replayed.size(), 3u);
+}
+
+TEST_F(EncoderLog, FullLogKeepsUnreadSteps) {
+    for (int i = 0; i < ENCODER_LOG_SIZE; i++) {
+        ASSERT_TRUE(step(i, i & 1));
+    }
+    EXPECT_FALSE(step(ENCODER_LOG_SIZE, true));
+
+    exchange();
+    EXPECT_EQ(replayed, sent);
+    EXPECT_TRUE(step(ENCODER_LOG_SIZE, true));
+}
+
+TEST_F(EncoderLog, LoopbackAtHighRates) {
+    std::vector<Step> steps;
+    srand(44);
+    for (int i = 0; i < 100000; i++) {
+        steps.push_back({uint8_t(rand() % 4), bool(rand() & 1)});
+    }
+
+    // many steps between infrequent transactions, with the slave holding back what doesn't fit
+    size_t next = 0;
+    while (next < steps.size()) {
+        for (int burst = rand() % (4 * ENCODER_LOG_SIZE); burst > 0 && next < steps.size(); burst--) {
+            if (!step(steps[next].index, steps[next].clockwise)) break;
+            next++;
+        }
+        exchange();
+    }
+    exchange();
+
+    EXPECT_EQ(sent, steps);
+    EXPECT_EQ(replayed, steps);
+}
+
+TEST_F(EncoderLog, TornReads) {
+    // the master reads the head before the steps, the slave keeps logging in between
+    for (int i = 0; i < 10000; i++) {
+        received.head = log.head;
+        for (int burst = rand() % ENCODER_LOG_SIZE; burst > 0; burst--) {
+            step(rand() % 2, rand() & 1);
+        }
+        memcpy(received.steps, log.steps, sizeof(received.steps));
+
+        Step step;
+        while (encoder_log_pop(&received, &tail, &step.index, &step.clockwise)) {
+            replayed.push_back(step);
+        }
+        ack = tail;
+    }
+    exchange();
+    EXPECT_EQ(replayed, sent);
+}
+
+TEST_F(EncoderLog, SlaveRestart) {
+    for (int i = 0; i < 57; i++) {
+        step(1, true);
+        exchange();
+    }
+    replayed.clear();
+
+    // the slave starts over, while the master is still acknowledging its old steps
+    log = {};
+    EXPECT_FALSE(encoder_log_push(&log, ack, 2, false));
+
+    exchange();
+    EXPECT_TRUE(replayed.empty());
+    EXPECT_EQ(ack, 0);
+
+    sent.clear();
+    ASSERT_TRUE(step(2, false));
+    exchange();
+    EXPECT_EQ(replayed, sent);
+}
+
+TEST_F(EncoderLog, InterleavedLoopback) {
+    static const int total = 20000;
+    srand(44);
+
+    // the transports copy the log a byte at a time, in the order of the struct, from an interrupt or
+    // DMA: the slave keeps logging steps, with the last acknowledgement it got, between any two bytes
+    int next = 0;
+    while (next < total) {
+        uint8_t *from = (uint8_t *)&log;
+        uint8_t *to   = (uint8_t *)&received;
+        for (size_t byte = 0; byte < sizeof(log); byte++) {
+            for (int burst = rand() % 3; burst > 0 && next < total; burst--) {
+                if (step(next % 3, next % 5 == 0)) next++;
+            }
+            to[byte] = from[byte];
+        }
+
+        Step step;
+        while (encoder_log_pop(&received, &tail, &step.index, &step.clockwise)) {
+            replayed.push_back(step);
+        }
+        ack = tail;
+    }
+    exchange();
+
+    ASSERT_EQ(sent.size(), (size_t)total);
+    EXPECT_EQ(replayed, sent);
+}
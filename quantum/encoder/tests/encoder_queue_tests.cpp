@@ -0,0 +1,168 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+extern "C" {
+#include "encoder_queue.h"
+}
+
+// Pin readings, A in bit 0 and B in bit 1, going through one full cycle
+static const uint8_t quadrature[] = {0b00, 0b01, 0b11, 0b10};
+
+class EncoderQueue : public ::testing::Test {
+   protected:
+    encoder_decoder_t decoders[2];
+    uint8_t           positions[2] = {0, 0};
+    uint16_t          time         = 0;
+
+    void SetUp() override {
+        encoder_queue_clear();
+        for (auto &decoder : decoders) {
+            encoder_decoder_init(&decoder, quadrature[0]);
+        }
+    }
+
+    // Turns an encoder by one transition, in the direction that decodes as negative steps
+    void turn(uint8_t index, bool backwards = false, uint8_t resolution = 4) {
+        positions[index] = (positions[index] + (backwards ? 3 : 1)) % 4;
+        encoder_decoder_sample(&decoders[index], index, quadrature[positions[index]], resolution, time);
+    }
+
+    int drain(uint8_t index) {
+        int             steps = 0;
+        encoder_event_t event;
+        while (encoder_queue_pop(&event)) {
+            EXPECT_EQ(event.index, index);
+            steps += event.steps;
+        }
+        return steps;
+    }
+};
+
+TEST_F(EncoderQueue, DecodesSteps) {
+    for (int i = 0; i < 4 * 3; i++) turn(0);
+    EXPECT_EQ(drain(0), -3);
+
+    for (int i = 0; i < 4 * 5; i++) turn(0, true);
+    EXPECT_EQ(drain(0), 5);
+
+    // an incomplete step stays in the decoder
+    for (int i = 0; i < 3; i++) turn(0);
+    EXPECT_EQ(drain(0), 0);
+    turn(0);
+    EXPECT_EQ(drain(0), -1);
+}
+
+TEST_F(EncoderQueue, Resolution) {
+    for (int i = 0; i < 4 * 3; i++) turn(0, false, 2);
+    EXPECT_EQ(drain(0), -6);
+}
+
+TEST_F(EncoderQueue, IgnoresBounce) {
+    for (int i = 0; i < 100; i++) {
+        turn(0);
+        turn(0, true);
+    }
+    // a repeated reading is no transition
+    encoder_decoder_sample(&decoders[0], 0, quadrature[positions[0]], 4, time);
+    EXPECT_EQ(drain(0), 0);
+}
+
+TEST_F(EncoderQueue, EventsInOrder) {
+    for (int i = 0; i < 4; i++) turn(0);
+    time = 10;
+    for (int i = 0; i < 4; i++) turn(1, true);
+
+    encoder_event_t event;
+    ASSERT_TRUE(encoder_queue_pop(&event));
+    EXPECT_EQ(event.index, 0);
+    EXPECT_EQ(event.steps, -1);
+    EXPECT_EQ(event.time, 0);
+    ASSERT_TRUE(encoder_queue_pop(&event));
+    EXPECT_EQ(event.index, 1);
+    EXPECT_EQ(event.steps, 1);
+    EXPECT_EQ(event.time, 10);
+    EXPECT_FALSE(encoder_queue_pop(&event));
+}
+
+TEST_F(EncoderQueue, FullQueueLosesNoSteps) {
+    // many more steps than the queue holds, while the main loop is busy
+    for (int i = 0; i < 4 * 100; i++) turn(0);
+
+    int             steps = 0, events = 0;
+    encoder_event_t event;
+    while (encoder_queue_pop(&event)) {
+        steps += event.steps;
+        events++;
+    }
+    EXPECT_EQ(events, ENCODER_QUEUE_SIZE - 1);
+
+    // the rest goes out with the next sample
+    encoder_decoder_sample(&decoders[0], 0, quadrature[positions[0]], 4, time);
+    steps += drain(0);
+    EXPECT_EQ(steps, -100);
+}
+
+TEST_F(EncoderQueue, ConcurrentProducer) {
+    // The sampling interrupt and the main loop, as two threads
+    const int         turns = 4 * 3000;
+    std::atomic<bool> done(false);
+    std::thread       producer([&] {
+        for (int i = 0; i < turns; i++) {
+            turn(0, i % 3000 >= 2000);
+            // the decoder holds back up to 127 steps, the main loop never falls that far behind
+            while (abs(decoders[0].pending) > 64) {
+                std::this_thread::yield();
+                encoder_decoder_sample(&decoders[0], 0, quadrature[positions[0]], 4, time);
+            }
+        }
+        done = true;
+    });
+
+    int             steps = 0;
+    encoder_event_t event;
+    while (!done) {
+        if (encoder_queue_pop(&event)) {
+            EXPECT_EQ(event.index, 0);
+            steps += event.steps;
+        }
+    }
+    producer.join();
+    encoder_decoder_sample(&decoders[0], 0, quadrature[positions[0]], 4, time);
+    steps += drain(0);
+
+    int expected = 0;
+    for (int i = 0; i < turns; i++) expected += i % 3000 >= 2000 ? 1 : -1;
+    EXPECT_EQ(steps, expected / 4);
+}
+
+TEST_F(EncoderQueue, Acceleration) {
+    EXPECT_EQ(encoder_acceleration(1000), 1);
+    EXPECT_EQ(encoder_acceleration(ENCODER_ACCELERATION_INTERVAL), 1);
+    EXPECT_EQ(encoder_acceleration(ENCODER_ACCELERATION_INTERVAL / 2), 2);
+    EXPECT_EQ(encoder_acceleration(0), ENCODER_ACCELERATION_MAX);
+    EXPECT_EQ(encoder_acceleration(1), ENCODER_ACCELERATION_MAX);
+
+    uint8_t previous = 1;
+    for (uint16_t interval = ENCODER_ACCELERATION_INTERVAL; interval > 0; interval--) {
+        EXPECT_GE(encoder_acceleration(interval), previous);
+        previous = encoder_acceleration(interval);
+    }
+}
@@ -0,0 +1,13 @@
+encoder_queue_DEFS := -DNO_DEBUG
+encoder_queue_INC := $(QUANTUM_PATH)/encoder
+
+encoder_queue_SRC := \
+	$(QUANTUM_PATH)/encoder/tests/encoder_queue_tests.cpp \
+	$(QUANTUM_PATH)/encoder/encoder_queue.c
+
+encoder_log_DEFS := -DNO_DEBUG
+encoder_log_INC := $(QUANTUM_PATH)/encoder
+
+encoder_log_SRC := \
+	$(QUANTUM_PATH)/encoder/tests/encoder_log_tests.cpp \
+	$(QUANTUM_PATH)/encoder/encoder_log.c
@@ -0,0 +1,2 @@
+TEST_LIST += encoder_queue
+TEST_LIST += encoder_log
@@ -0,0 +1,40 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "leader_trie.h"
+#include "progmem.h"
+
+uint16_t leader_trie_action(const uint16_t *trie, uint16_t node) { return pgm_read_word(&trie[node]); }
+
+leader_trie_result_t leader_trie_step(const uint16_t *trie, uint16_t *node, uint16_t keycode) {
+    uint16_t        count = pgm_read_word(&trie[*node + 1]);
+    const uint16_t *child = &trie[*node + 2];
+
+    for (; count > 0; count--, child += 2) {
+        if (pgm_read_word(&child[0]) != keycode) {
+            continue;
+        }
+
+        uint16_t next = pgm_read_word(&child[1]);
+        *node         = next;
+        if (pgm_read_word(&trie[next]) == LEADER_TRIE_NO_ACTION) {
+            return LEADER_TRIE_PARTIAL;
+        }
+        return pgm_read_word(&trie[next + 1]) ? LEADER_TRIE_AMBIGUOUS : LEADER_TRIE_COMPLETE;
+    }
+
+    return LEADER_TRIE_NO_MATCH;
+}
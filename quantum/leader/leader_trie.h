@@ -0,0 +1,48 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* Leader sequence trie
+ *
+ * The trie is a flat array of 16-bit words, normally generated by
+ * `qmk generate-leader-trie` and stored in PROGMEM. Every node is laid out as
+ *
+ *     action, child_count, (keycode, child_offset) * child_count
+ *
+ * where `action` is the index reported once the sequence ending at this node
+ * is complete (or LEADER_TRIE_NO_ACTION), and `child_offset` is the word
+ * offset of the child node from the start of the array. The root node is
+ * always at offset 0.
+ */
+
+#define LEADER_TRIE_ROOT 0
+#define LEADER_TRIE_NO_ACTION 0xFFFF
+
+typedef enum {
+    LEADER_TRIE_NO_MATCH,   // keycode does not continue any sequence
+    LEADER_TRIE_PARTIAL,    // prefix of at least one sequence, nothing to fire yet
+    LEADER_TRIE_AMBIGUOUS,  // a sequence is complete, but longer ones share its prefix
+    LEADER_TRIE_COMPLETE,   // a sequence is complete and nothing else can follow
+} leader_trie_result_t;
+
+/* Advances `*node` by one keycode. `*node` is left untouched on NO_MATCH. */
+leader_trie_result_t leader_trie_step(const uint16_t *trie, uint16_t *node, uint16_t keycode);
+
+/* Action index of the sequence ending at `node`, or LEADER_TRIE_NO_ACTION. */
+uint16_t leader_trie_action(const uint16_t *trie, uint16_t node);
@@ -0,0 +1,222 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <map>
+#include <vector>
+
+extern "C" {
+#include "leader_trie.h"
+}
+
+using Sequence = std::vector<uint16_t>;
+
+// Same layout as `qmk generate-leader-trie`, built breadth first
+static std::vector<uint16_t> build_trie(const std::vector<Sequence>& sequences) {
+    struct Node {
+        uint16_t                  action = LEADER_TRIE_NO_ACTION;
+        std::map<uint16_t, Node*> children;
+    };
+    std::vector<Node*> owned;
+    Node*              root = new Node();
+    owned.push_back(root);
+
+    for (uint16_t i = 0; i < sequences.size(); i++) {
+        Node* node = root;
+        for (uint16_t key : sequences[i]) {
+            Node*& child = node->children[key];
+            if (!child) {
+                child = new Node();
+                owned.push_back(child);
+            }
+            node = child;
+        }
+        node->action = i;
+    }
+
+    std::vector<Node*>      order = {root};
+    std::map<Node*, size_t> offsets;
+    size_t                  offset = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        offsets[order[i]] = offset;
+        offset += 2 + 2 * order[i]->children.size();
+        for (auto& child : order[i]->children) {
+            order.push_back(child.second);
+        }
+    }
+
+    std::vector<uint16_t> trie;
+    for (Node* node : order) {
+        trie.push_back(node->action);
+        trie.push_back(node->children.size());
+        for (auto& child : node->children) {
+            trie.push_back(child.first);
+            trie.push_back(offsets[child.second]);
+        }
+    }
+
+    for (Node* node : owned) {
+        delete node;
+    }
+    return trie;
+}
+
+// Feeds `keys` through the trie and returns the action that process_leader would fire.
+// `consumed` is set to the number of keys taken before the sequence finished.
+static uint16_t match_trie(const std::vector<uint16_t>& trie, const Sequence& keys, size_t* consumed = nullptr) {
+    uint16_t node = LEADER_TRIE_ROOT;
+    size_t   dummy;
+    if (!consumed) {
+        consumed = &dummy;
+    }
+    *consumed = 0;
+    for (uint16_t key : keys) {
+        (*consumed)++;
+        switch (leader_trie_step(trie.data(), &node, key)) {
+            case LEADER_TRIE_NO_MATCH:
+                return LEADER_TRIE_NO_ACTION;
+            case LEADER_TRIE_COMPLETE:
+                return leader_trie_action(trie.data(), node);
+            default:
+                break;
+        }
+    }
+    // Timed out
+    return leader_trie_action(trie.data(), node);
+}
+
+// What a chain of SEQ_*_KEYS blocks does, for comparison
+static uint16_t match_linear(const std::vector<Sequence>& sequences, const Sequence& keys) {
+    for (uint16_t i = 0; i < sequences.size(); i++) {
+        if (sequences[i] == keys) {
+            return i;
+        }
+    }
+    return LEADER_TRIE_NO_ACTION;
+}
+
+static std::vector<Sequence> generate_sequences(size_t count) {
+    std::vector<Sequence> sequences;
+    uint32_t              seed = 1;
+    while (sequences.size() < count) {
+        seed = seed * 1103515245 + 12345;
+        // 2 to 7 keys, from a 10 key alphabet so that prefixes are shared
+        Sequence sequence(2 + (seed >> 16) % 6);
+        for (auto& key : sequence) {
+            seed = seed * 1103515245 + 12345;
+            key  = 4 + (seed >> 16) % 10;
+        }
+        if (match_linear(sequences, sequence) == LEADER_TRIE_NO_ACTION) {
+            sequences.push_back(sequence);
+        }
+    }
+    return sequences;
+}
+
+class LeaderTrie : public ::testing::Test {};
+
+TEST_F(LeaderTrie, EmptyTrieMatchesNothing) {
+    auto     trie = build_trie({});
+    uint16_t node = LEADER_TRIE_ROOT;
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 4), LEADER_TRIE_NO_MATCH);
+    EXPECT_EQ(node, LEADER_TRIE_ROOT);
+    EXPECT_EQ(leader_trie_action(trie.data(), node), LEADER_TRIE_NO_ACTION);
+}
+
+TEST_F(LeaderTrie, UnambiguousSequenceCompletesImmediately) {
+    auto     trie = build_trie({{4, 5}, {6}});
+    uint16_t node = LEADER_TRIE_ROOT;
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 4), LEADER_TRIE_PARTIAL);
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 5), LEADER_TRIE_COMPLETE);
+    EXPECT_EQ(leader_trie_action(trie.data(), node), 0);
+
+    node = LEADER_TRIE_ROOT;
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 6), LEADER_TRIE_COMPLETE);
+    EXPECT_EQ(leader_trie_action(trie.data(), node), 1);
+}
+
+TEST_F(LeaderTrie, PrefixOfLongerSequenceIsAmbiguous) {
+    auto     trie = build_trie({{7, 7}, {7, 7, 22}});
+    uint16_t node = LEADER_TRIE_ROOT;
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 7), LEADER_TRIE_PARTIAL);
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 7), LEADER_TRIE_AMBIGUOUS);
+    EXPECT_EQ(leader_trie_action(trie.data(), node), 0);
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 22), LEADER_TRIE_COMPLETE);
+    EXPECT_EQ(leader_trie_action(trie.data(), node), 1);
+}
+
+TEST_F(LeaderTrie, WrongKeyStopsMatching) {
+    auto     trie = build_trie({{4, 5, 6}});
+    uint16_t node = LEADER_TRIE_ROOT;
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 4), LEADER_TRIE_PARTIAL);
+    uint16_t before = node;
+    EXPECT_EQ(leader_trie_step(trie.data(), &node, 6), LEADER_TRIE_NO_MATCH);
+    EXPECT_EQ(node, before);
+}
+
+TEST_F(LeaderTrie, SequencesLongerThanFiveKeys) {
+    Sequence long_sequence = {4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    auto     trie          = build_trie({long_sequence, {4, 5, 6, 7, 8}});
+    EXPECT_EQ(match_trie(trie, long_sequence), 0);
+    EXPECT_EQ(match_trie(trie, {4, 5, 6, 7, 8}), 1);
+    EXPECT_EQ(match_trie(trie, {4, 5, 6, 7, 8, 9}), LEADER_TRIE_NO_ACTION);
+}
+
+TEST_F(LeaderTrie, MatchesLinearDictionary) {
+    auto sequences = generate_sequences(500);
+    auto trie      = build_trie(sequences);
+
+    for (const auto& sequence : sequences) {
+        EXPECT_EQ(match_trie(trie, sequence), match_linear(sequences, sequence));
+    }
+    // Unknown input either fails or fires as soon as a complete sequence is typed
+    for (const auto& sequence : generate_sequences(1000)) {
+        size_t   consumed;
+        uint16_t action = match_trie(trie, sequence, &consumed);
+        if (action != LEADER_TRIE_NO_ACTION) {
+            EXPECT_EQ(action, match_linear(sequences, Sequence(sequence.begin(), sequence.begin() + consumed)));
+        } else {
+            EXPECT_EQ(match_linear(sequences, sequence), LEADER_TRIE_NO_ACTION);
+        }
+    }
+}
+
+TEST_F(LeaderTrie, Benchmark) {
+    auto sequences = generate_sequences(500);
+    auto trie      = build_trie(sequences);
+    auto lookups   = generate_sequences(1000);
+
+    volatile uint16_t sink;
+    auto              start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; i++) {
+        for (const auto& sequence : lookups) {
+            sink = match_trie(trie, sequence);
+        }
+    }
+    auto trie_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; i++) {
+        for (const auto& sequence : lookups) {
+            sink = match_linear(sequences, sequence);
+        }
+    }
+    auto linear_time = std::chrono::steady_clock::now() - start;
+
+    (void)sink;
+    printf("%zu sequences, %zu trie words: trie %lld us, linear %lld us\n", sequences.size(), trie.size(), (long long)std::chrono::duration_cast<std::chrono::microseconds>(trie_time).count(), (long long)std::chrono::duration_cast<std::chrono::microseconds>(linear_time).count());
+}
@@ -0,0 +1,5 @@
+leader_trie_DEFS := -DNO_DEBUG
+
+leader_trie_SRC := \
+	$(QUANTUM_PATH)/leader/tests/leader_trie_tests.cpp \
+	$(QUANTUM_PATH)/leader/leader_trie.c
@@ -0,0 +1 @@
+TEST_LIST += leader_trie
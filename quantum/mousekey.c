@@ -40,7 +40,141 @@ static uint8_t        mousekey_wheel_repeat = 0;
 static uint16_t mouse_timer = 0;
 #endif
 
-#ifndef MK_3_SPEED
+#if defined(MK_PHYSICS)
+
+/*
+ * Mouse keys physics
+ *
+ * The speed and position of the cursor and the wheel are integrated in fixed
+ * point every MOUSEKEY_FRAME_INTERVAL, see mousekey_physics.h, and each report
+ * carries the whole pixels or detents moved since the last one.
+ */
+mousekey_curve_t mousekey_curves[MOUSEKEY_CURVE_COUNT] = {
+    [MOUSEKEY_CURVE_MOVE] =
+        {
+            .step          = MOUSEKEY_MOVE_DELTA,
+            .delay         = MOUSEKEY_DELAY,
+            .initial_speed = MOUSEKEY_INITIAL_SPEED,
+            .acceleration  = MOUSEKEY_ACCELERATION,
+            .max_speed     = MOUSEKEY_BASE_SPEED,
+            .friction      = MOUSEKEY_FRICTION,
+        },
+    [MOUSEKEY_CURVE_WHEEL] =
+        {
+            .step          = MOUSEKEY_WHEEL_DELTA,
+            .delay         = MOUSEKEY_WHEEL_DELAY,
+            .initial_speed = MOUSEKEY_WHEEL_INITIAL_MOVEMENTS,
+            .acceleration  = MOUSEKEY_WHEEL_ACCELERATION,
+            .max_speed     = MOUSEKEY_WHEEL_BASE_MOVEMENTS,
+            .friction      = MOUSEKEY_WHEEL_FRICTION,
+        },
+};
+
+/* x and y for the cursor, v and h for the wheel */
+static mousekey_motion_t cursor_motion = {.scale = {1, 1}};
+static mousekey_motion_t wheel_motion  = {.scale = {1, 1}};
+static uint16_t          last_frame    = 0;
+
+/* the accel keys move at a quarter, half or all of the maximum speed */
+static uint16_t fixed_speed(const mousekey_curve_t *curve) {
+    if (mousekey_accel & (1 << 0)) return curve->max_speed / 4;
+    if (mousekey_accel & (1 << 1)) return curve->max_speed / 2;
+    if (mousekey_accel & (1 << 2)) return curve->max_speed;
+    return 0;
+}
+
+static void update_wheel_scale(void) {
+#    ifdef MOUSE_HIRES_SCROLL
+    wheel_motion.scale[0] = mouse_resolution_report.v ? MOUSE_HIRES_SCROLL_MULTIPLIER : 1;
+    wheel_motion.scale[1] = mouse_resolution_report.h ? MOUSE_HIRES_SCROLL_MULTIPLIER : 1;
+#    endif
+}
+
+static void take_motion(void) {
+    mouse_report.x = mousekey_motion_take(&cursor_motion, 0, MOUSE_REPORT_XY_MAX);
+    mouse_report.y = mousekey_motion_take(&cursor_motion, 1, MOUSE_REPORT_XY_MAX);
+    mouse_report.v = mousekey_motion_take(&wheel_motion, 0, MOUSEKEY_WHEEL_MAX);
+    mouse_report.h = mousekey_motion_take(&wheel_motion, 1, MOUSEKEY_WHEEL_MAX);
+}
+
+void mousekey_task(void) {
+    if (!mousekey_motion_active(&cursor_motion) && !mousekey_motion_active(&wheel_motion)) {
+        last_frame = timer_read();
+        return;
+    }
+
+    uint16_t elapsed = timer_elapsed(last_frame);
+    if (elapsed < MOUSEKEY_FRAME_INTERVAL) return;
+    last_frame += elapsed;
+
+    update_wheel_scale();
+    mousekey_motion_update(&cursor_motion, &mousekey_curves[MOUSEKEY_CURVE_MOVE], fixed_speed(&mousekey_curves[MOUSEKEY_CURVE_MOVE]), elapsed);
+    mousekey_motion_update(&wheel_motion, &mousekey_curves[MOUSEKEY_CURVE_WHEEL], fixed_speed(&mousekey_curves[MOUSEKEY_CURVE_WHEEL]), elapsed);
+    take_motion();
+
+    if (mouse_report.x || mouse_report.y || mouse_report.v || mouse_report.h) mousekey_send();
+}
+
+void mousekey_on(uint8_t code) {
+    const mousekey_curve_t *move  = &mousekey_curves[MOUSEKEY_CURVE_MOVE];
+    const mousekey_curve_t *wheel = &mousekey_curves[MOUSEKEY_CURVE_WHEEL];
+
+    update_wheel_scale();
+    if (code == KC_MS_UP)
+        mousekey_motion_press(&cursor_motion, move, 1, -1);
+    else if (code == KC_MS_DOWN)
+        mousekey_motion_press(&cursor_motion, move, 1, 1);
+    else if (code == KC_MS_LEFT)
+        mousekey_motion_press(&cursor_motion, move, 0, -1);
+    else if (code == KC_MS_RIGHT)
+        mousekey_motion_press(&cursor_motion, move, 0, 1);
+    else if (code == KC_MS_WH_UP)
+        mousekey_motion_press(&wheel_motion, wheel, 0, 1);
+    else if (code == KC_MS_WH_DOWN)
+        mousekey_motion_press(&wheel_motion, wheel, 0, -1);
+    else if (code == KC_MS_WH_LEFT)
+        mousekey_motion_press(&wheel_motion, wheel, 1, -1);
+    else if (code == KC_MS_WH_RIGHT)
+        mousekey_motion_press(&wheel_motion, wheel, 1, 1);
+    else if (IS_MOUSEKEY_BUTTON(code))
+        mouse_report.buttons |= 1 << (code - KC_MS_BTN1);
+    else if (code == KC_MS_ACCEL0)
+        mousekey_accel |= (1 << 0);
+    else if (code == KC_MS_ACCEL1)
+        mousekey_accel |= (1 << 1);
+    else if (code == KC_MS_ACCEL2)
+        mousekey_accel |= (1 << 2);
+    take_motion();
+}
+
+void mousekey_off(uint8_t code) {
+    if (code == KC_MS_UP)
+        mousekey_motion_release(&cursor_motion, 1, -1);
+    else if (code == KC_MS_DOWN)
+        mousekey_motion_release(&cursor_motion, 1, 1);
+    else if (code == KC_MS_LEFT)
+        mousekey_motion_release(&cursor_motion, 0, -1);
+    else if (code == KC_MS_RIGHT)
+        mousekey_motion_release(&cursor_motion, 0, 1);
+    else if (code == KC_MS_WH_UP)
+        mousekey_motion_release(&wheel_motion, 0, 1);
+    else if (code == KC_MS_WH_DOWN)
+        mousekey_motion_release(&wheel_motion, 0, -1);
+    else if (code == KC_MS_WH_LEFT)
+        mousekey_motion_release(&wheel_motion, 1, -1);
+    else if (code == KC_MS_WH_RIGHT)
+        mousekey_motion_release(&wheel_motion, 1, 1);
+    else if (IS_MOUSEKEY_BUTTON(code))
+        mouse_report.buttons &= ~(1 << (code - KC_MS_BTN1));
+    else if (code == KC_MS_ACCEL0)
+        mousekey_accel &= ~(1 << 0);
+    else if (code == KC_MS_ACCEL1)
+        mousekey_accel &= ~(1 << 1);
+    else if (code == KC_MS_ACCEL2)
+        mousekey_accel &= ~(1 << 2);
+}
+
+#elif !defined(MK_3_SPEED)
 
 static uint16_t last_timer_c = 0;
 static uint16_t last_timer_w = 0;
@@ -322,7 +456,7 @@ void mousekey_off(uint8_t code) {
     if (mouse_report.v == 0 && mouse_report.h == 0) mousekey_wheel_repeat = 0;
 }
 
-#else /* #ifndef MK_3_SPEED */
+#else /* #if defined(MK_PHYSICS) */
 
 enum { mkspd_unmod, mkspd_0, mkspd_1, mkspd_2, mkspd_COUNT };
 #    ifndef MK_MOMENTARY_ACCEL
@@ -451,14 +585,48 @@ void mousekey_off(uint8_t code) {
 #    endif
 }
 
-#endif /* #ifndef MK_3_SPEED */
+#endif /* #if defined(MK_PHYSICS) */
+
+#if defined(MOUSE_HIRES_SCROLL) && !defined(MK_PHYSICS)
+/* Takes a detent of the wheel keys' scrolling, in the unit the host expects */
+static int8_t hires_wheel_step(int8_t *detents, uint8_t hires) {
+    int8_t step = *detents;
+    if (hires && step > 0) step = 1;
+    if (hires && step < 0) step = -1;
+    *detents -= step;
+    return hires ? step * MOUSE_HIRES_SCROLL_MULTIPLIER : step;
+}
+#endif
 
 void mousekey_send(void) {
     mousekey_debug();
+#if defined(MK_PHYSICS)
+    // The report carries the motion taken since the last one, already in the host's units
+    host_mouse_send(&mouse_report);
+    mouse_report.x = 0;
+    mouse_report.y = 0;
+    mouse_report.v = 0;
+    mouse_report.h = 0;
+#else
     uint16_t time = timer_read();
     if (mouse_report.x || mouse_report.y) last_timer_c = time;
     if (mouse_report.v || mouse_report.h) last_timer_w = time;
+#    ifdef MOUSE_HIRES_SCROLL
+    // The wheel keys scroll whole detents, one per report when the host counts finer steps
+    report_mouse_t report = mouse_report;
+    int8_t         v      = mouse_report.v;
+    int8_t         h      = mouse_report.h;
+    do {
+        report.v = hires_wheel_step(&v, mouse_resolution_report.v);
+        report.h = hires_wheel_step(&h, mouse_resolution_report.h);
+        host_mouse_send(&report);
+        report.x = 0;
+        report.y = 0;
+    } while (v || h);
+#    else
     host_mouse_send(&mouse_report);
+#    endif
+#endif
 }
 
 void mousekey_clear(void) {
@@ -466,6 +634,10 @@ void mousekey_clear(void) {
     mousekey_repeat       = 0;
     mousekey_wheel_repeat = 0;
     mousekey_accel        = 0;
+#ifdef MK_PHYSICS
+    mousekey_motion_init(&cursor_motion);
+    mousekey_motion_init(&wheel_motion);
+#endif
 }
 
 static void mousekey_debug(void) {
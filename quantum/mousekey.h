@@ -157,10 +157,51 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #endif /* #ifndef MK_3_SPEED */
 
+#ifdef MK_PHYSICS
+#    if defined(MK_3_SPEED) || defined(MK_COMBINED) || defined(MK_KINETIC_SPEED)
+#        error "MK_PHYSICS can not be combined with another mouse key mode"
+#    endif
+
+#    include "mousekey_physics.h"
+
+/* milliseconds between reports while moving, one per poll of the mouse endpoint */
+#    ifndef MOUSEKEY_FRAME_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define MOUSEKEY_FRAME_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define MOUSEKEY_FRAME_INTERVAL 10
+#        endif
+#    endif
+#    ifndef MOUSEKEY_ACCELERATION
+#        define MOUSEKEY_ACCELERATION 1000
+#    endif
+#    ifndef MOUSEKEY_FRICTION
+#        define MOUSEKEY_FRICTION 0
+#    endif
+#    ifndef MOUSEKEY_WHEEL_ACCELERATION
+#        define MOUSEKEY_WHEEL_ACCELERATION 16
+#    endif
+#    ifndef MOUSEKEY_WHEEL_FRICTION
+#        define MOUSEKEY_WHEEL_FRICTION 0
+#    endif
+
+enum mousekey_curve_id {
+    MOUSEKEY_CURVE_MOVE,
+    MOUSEKEY_CURVE_WHEEL,
+    MOUSEKEY_CURVE_COUNT,
+};
+
+#endif /* #ifdef MK_PHYSICS */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef MK_PHYSICS
+/* the curves of the cursor and the wheel, which can be changed at any time */
+extern mousekey_curve_t mousekey_curves[MOUSEKEY_CURVE_COUNT];
+#endif
+
 extern uint8_t mk_delay;
 extern uint8_t mk_interval;
 extern uint8_t mk_max_speed;
@@ -0,0 +1,125 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mousekey_physics.h"
+
+// Longer gaps, as when the keyboard was busy, are not made up for
+#define MAX_ELAPSED_MS 250
+
+#define FIXED(units) ((uint32_t)(units) << MOUSEKEY_MOTION_FRACTION)
+#define UNIT ((int32_t)1 << MOUSEKEY_MOTION_FRACTION)
+
+// Divides a rate by the milliseconds in a second, keeping the remainder for the next time
+static uint32_t per_ms(uint32_t rate, uint16_t elapsed_ms, uint16_t *carry) {
+    uint32_t total = rate * elapsed_ms + *carry;
+    *carry         = total % 1000;
+    return total / 1000;
+}
+
+static void stop(mousekey_motion_t *motion) {
+    mousekey_motion_t stopped = {.scale = {motion->scale[0], motion->scale[1]}};
+    *motion                   = stopped;
+}
+
+void mousekey_motion_init(mousekey_motion_t *motion) {
+    *motion = (mousekey_motion_t){.scale = {1, 1}};
+}
+
+void mousekey_motion_press(mousekey_motion_t *motion, const mousekey_curve_t *curve, uint8_t axis, int8_t direction) {
+    if (!motion->direction[0] && !motion->direction[1]) {
+        // a press while still or coasting starts the motion over
+        stop(motion);
+    }
+    motion->direction[axis] = direction;
+    motion->position[axis] += direction * UNIT * curve->step * motion->scale[axis];
+}
+
+void mousekey_motion_release(mousekey_motion_t *motion, uint8_t axis, int8_t direction) {
+    if (motion->direction[axis] == direction) {
+        motion->direction[axis] = 0;
+    }
+}
+
+void mousekey_motion_update(mousekey_motion_t *motion, const mousekey_curve_t *curve, uint16_t fixed_speed, uint16_t elapsed_ms) {
+    if (elapsed_ms > MAX_ELAPSED_MS) {
+        elapsed_ms = MAX_ELAPSED_MS;
+    }
+
+    if (motion->direction[0] || motion->direction[1]) {
+        motion->heading[0] = motion->direction[0];
+        motion->heading[1] = motion->direction[1];
+
+        if (motion->waited < curve->delay) {
+            uint16_t left = curve->delay - motion->waited;
+            if (elapsed_ms < left) {
+                motion->waited += elapsed_ms;
+                return;
+            }
+            motion->waited = curve->delay;
+            elapsed_ms -= left;
+        }
+
+        if (fixed_speed) {
+            motion->speed = FIXED(fixed_speed);
+        } else {
+            if (motion->speed < FIXED(curve->initial_speed)) {
+                motion->speed = FIXED(curve->initial_speed);
+            }
+            motion->speed += per_ms(FIXED(curve->acceleration), elapsed_ms, &motion->speed_carry);
+            if (motion->speed > FIXED(curve->max_speed)) {
+                motion->speed = FIXED(curve->max_speed);
+            }
+        }
+    } else {
+        uint32_t lost = curve->friction ? per_ms(FIXED(curve->friction), elapsed_ms, &motion->speed_carry) : motion->speed;
+        motion->speed = motion->speed > lost ? motion->speed - lost : 0;
+        if (!motion->speed) {
+            // drop the fraction of a unit left, so the next press starts from a whole one
+            stop(motion);
+            return;
+        }
+    }
+
+    uint32_t speed = motion->speed;
+    if (motion->heading[0] && motion->heading[1]) {
+        // 181/256 is pretty close to 1/sqrt(2)
+        speed = (speed * 181) >> 8;
+    }
+    uint32_t distance = per_ms(speed, elapsed_ms, &motion->carry);
+
+    motion->position[0] += motion->heading[0] * (int32_t)(distance * motion->scale[0]);
+    motion->position[1] += motion->heading[1] * (int32_t)(distance * motion->scale[1]);
+}
+
+int16_t mousekey_motion_take(mousekey_motion_t *motion, uint8_t axis, int16_t limit) {
+    int32_t counts = motion->position[axis] / UNIT;
+    if (counts > limit) {
+        counts = limit;
+    } else if (counts < -limit) {
+        counts = -limit;
+    }
+    motion->position[axis] -= counts * UNIT;
+
+    // motion faster than the reports can carry is not saved up for later
+    if (motion->position[axis] > limit * UNIT) {
+        motion->position[axis] = limit * UNIT;
+    } else if (motion->position[axis] < -limit * UNIT) {
+        motion->position[axis] = -limit * UNIT;
+    }
+    return counts;
+}
+
+bool mousekey_motion_active(const mousekey_motion_t *motion) { return motion->direction[0] || motion->direction[1] || motion->speed; }
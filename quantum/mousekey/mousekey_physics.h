@@ -0,0 +1,86 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Mouse key motion, integrated in fixed point. The speed and the position are
+ * kept in 1/256 units, so the motion of every report carries the fraction the
+ * reports before it couldn't send, and the cursor travels as far as the curve
+ * says whatever the report rate is.
+ *
+ * A unit is a pixel for the cursor and a wheel detent for the wheel, which
+ * the scale of an axis divides when the host counts finer steps.
+ */
+
+#define MOUSEKEY_MOTION_FRACTION 8
+
+typedef struct {
+    uint16_t step;           // units moved at once when a key is pressed
+    uint16_t delay;          // milliseconds between the press and the start of the motion
+    uint16_t initial_speed;  // units per second when the motion starts
+    uint16_t acceleration;   // units per second gained every second
+    uint16_t max_speed;      // units per second
+    uint16_t friction;       // units per second lost every second after the keys are released, 0 to stop at once
+} mousekey_curve_t;
+
+typedef struct {
+    uint32_t speed;         // units per second, in 1/256 units
+    uint16_t speed_carry;   // thousandths of the last speed change not applied yet
+    uint16_t carry;         // thousandths of the last distance not moved yet
+    int32_t  position[2];   // motion not reported yet, in 1/256 units
+    int8_t   direction[2];  // of the keys held
+    int8_t   heading[2];    // of the motion, which goes on after the keys are released
+    uint16_t waited;        // milliseconds of the delay gone by
+    uint8_t  scale[2];      // host counts per unit along each axis, 1 to 127
+} mousekey_motion_t;
+
+/**
+ * Stops the motion, and counts whole units until the scale is set.
+ */
+void mousekey_motion_init(mousekey_motion_t *motion);
+
+/**
+ * Starts moving along an axis, 0 or 1, in a direction, -1 or 1.
+ */
+void mousekey_motion_press(mousekey_motion_t *motion, const mousekey_curve_t *curve, uint8_t axis, int8_t direction);
+
+/**
+ * Stops moving along an axis, unless it was pressed the other way since.
+ */
+void mousekey_motion_release(mousekey_motion_t *motion, uint8_t axis, int8_t direction);
+
+/**
+ * Moves on by the time since the last update.
+ *
+ * @param fixed_speed units per second to move at regardless of the curve, or 0
+ */
+void mousekey_motion_update(mousekey_motion_t *motion, const mousekey_curve_t *curve, uint16_t fixed_speed, uint16_t elapsed_ms);
+
+/**
+ * Takes the whole counts moved along an axis, keeping the fraction for the next report.
+ *
+ * @param limit the most counts a report can carry
+ */
+int16_t mousekey_motion_take(mousekey_motion_t *motion, uint8_t axis, int16_t limit);
+
+/**
+ * @return true while the keys are held or the motion coasts to a stop
+ */
+bool mousekey_motion_active(const mousekey_motion_t *motion);
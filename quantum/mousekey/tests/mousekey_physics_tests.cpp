@@ -0,0 +1,168 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "mousekey_physics.h"
+}
+
+class MousekeyPhysics : public ::testing::Test {
+   protected:
+    mousekey_curve_t  curve = {.step = 1, .delay = 100, .initial_speed = 50, .acceleration = 500, .max_speed = 1000, .friction = 0};
+    mousekey_motion_t motion;
+
+    void SetUp() override { mousekey_motion_init(&motion); }
+
+    // runs the motion for a time at a frame rate, and returns the counts reported along an axis
+    int32_t run(uint16_t ms, uint16_t frame_ms, uint8_t axis = 0, uint16_t fixed_speed = 0, int16_t limit = 127) {
+        int32_t total = 0;
+        for (uint16_t time = 0; time < ms; time += frame_ms) {
+            mousekey_motion_update(&motion, &curve, fixed_speed, frame_ms);
+            total += mousekey_motion_take(&motion, axis, limit);
+        }
+        return total;
+    }
+};
+
+TEST_F(MousekeyPhysics, PressStepsAtOnceThenWaitsForTheDelay) {
+    mousekey_motion_press(&motion, &curve, 0, -1);
+    EXPECT_EQ(mousekey_motion_take(&motion, 0, 127), -1);
+    EXPECT_EQ(run(100, 10), 0);
+    EXPECT_TRUE(mousekey_motion_active(&motion));
+
+    // 50 units per second, plus what the acceleration adds in the first 100ms
+    int32_t moved = run(100, 10);
+    EXPECT_LE(moved, -5);
+    EXPECT_GE(moved, -8);
+}
+
+TEST_F(MousekeyPhysics, DistanceDoesNotDependOnTheFrameRate) {
+    int32_t totals[4];
+    uint16_t frames[4] = {1, 2, 8, 10};
+
+    for (int i = 0; i < 4; i++) {
+        mousekey_motion_init(&motion);
+        mousekey_motion_press(&motion, &curve, 1, 1);
+        totals[i] = mousekey_motion_take(&motion, 1, 127) + run(2000, frames[i], 1);
+    }
+    for (int i = 1; i < 4; i++) {
+        EXPECT_NEAR(totals[i], totals[0], totals[0] / 50) << "at " << frames[i] << "ms frames";
+    }
+    // 1 step, then 1.9s accelerating from 50 to 1000 units per second in another 1.9s
+    EXPECT_NEAR(totals[0], 1 + 50 * 1.9 + 500 * 1.9 * 1.9 / 2, 20);
+}
+
+TEST_F(MousekeyPhysics, SlowMotionIsNotLost) {
+    curve = (mousekey_curve_t){.step = 0, .delay = 0, .initial_speed = 3, .acceleration = 0, .max_speed = 3, .friction = 0};
+    mousekey_motion_press(&motion, &curve, 0, 1);
+
+    // 3 units per second never reach a whole unit in one frame
+    EXPECT_EQ(run(1000, 1), 3);
+    EXPECT_EQ(run(1000, 1), 3);
+
+    // nor along a diagonal
+    mousekey_motion_press(&motion, &curve, 1, 1);
+    EXPECT_EQ(run(10000, 1, 1), 21);
+}
+
+TEST_F(MousekeyPhysics, SpeedIsLimited) {
+    mousekey_motion_press(&motion, &curve, 0, 1);
+    mousekey_motion_take(&motion, 0, 127);
+    run(10000, 10);
+    EXPECT_EQ(run(1000, 10), 1000);
+    EXPECT_EQ(run(1000, 10, 0, 200), 200);
+}
+
+TEST_F(MousekeyPhysics, ReportsAreLimited) {
+    curve.delay = 0;
+    mousekey_motion_press(&motion, &curve, 0, 1);
+    mousekey_motion_take(&motion, 0, 127);
+
+    // 1000 units per second at 100ms frames are more than the reports can carry, and the rest is dropped
+    EXPECT_EQ(run(1000, 100, 0, 1000, 50), 500);
+    mousekey_motion_release(&motion, 0, 1);
+    mousekey_motion_update(&motion, &curve, 0, 10);
+    EXPECT_EQ(mousekey_motion_take(&motion, 0, 50), 0);
+}
+
+TEST_F(MousekeyPhysics, ReleaseStopsOrCoasts) {
+    curve.delay = 0;
+    mousekey_motion_press(&motion, &curve, 0, 1);
+    run(1000, 10);
+    mousekey_motion_release(&motion, 0, 1);
+    EXPECT_EQ(run(100, 10), 0);
+    EXPECT_FALSE(mousekey_motion_active(&motion));
+
+    curve.friction = 1000;
+    mousekey_motion_press(&motion, &curve, 0, 1);
+    run(1000, 10);
+    mousekey_motion_release(&motion, 0, 1);
+    // from 550 units per second, losing 1000 every second
+    EXPECT_NEAR(run(1000, 10), 550 * 0.55 / 2, 10);
+    EXPECT_FALSE(mousekey_motion_active(&motion));
+}
+
+TEST_F(MousekeyPhysics, ReleaseOfTheOtherDirectionKeepsMoving) {
+    mousekey_motion_press(&motion, &curve, 0, 1);
+    mousekey_motion_press(&motion, &curve, 0, -1);
+    mousekey_motion_release(&motion, 0, 1);
+    EXPECT_TRUE(mousekey_motion_active(&motion));
+    EXPECT_EQ(mousekey_motion_take(&motion, 0, 127), 0);
+    EXPECT_LT(run(1000, 10), 0);
+}
+
+TEST_F(MousekeyPhysics, DiagonalsMoveAsFast) {
+    curve.delay = 0;
+    mousekey_motion_press(&motion, &curve, 0, 1);
+    mousekey_motion_press(&motion, &curve, 1, -1);
+    mousekey_motion_take(&motion, 0, 127);
+    mousekey_motion_take(&motion, 1, 127);
+
+    int32_t x = 0, y = 0;
+    for (int frame = 0; frame < 100; frame++) {
+        mousekey_motion_update(&motion, &curve, 1000, 10);
+        x += mousekey_motion_take(&motion, 0, 127);
+        y += mousekey_motion_take(&motion, 1, 127);
+    }
+    EXPECT_NEAR(x, 707, 2);
+    EXPECT_NEAR(y, -707, 2);
+}
+
+TEST_F(MousekeyPhysics, ScaleCountsFinerSteps) {
+    motion.scale[0] = 120;
+    curve           = (mousekey_curve_t){.step = 1, .delay = 0, .initial_speed = 10, .acceleration = 0, .max_speed = 10, .friction = 0};
+    mousekey_motion_press(&motion, &curve, 0, -1);
+    mousekey_motion_press(&motion, &curve, 1, 1);
+    EXPECT_EQ(mousekey_motion_take(&motion, 0, 127), -120);
+    EXPECT_EQ(mousekey_motion_take(&motion, 1, 127), 1);
+
+    int32_t x = 0, y = 0;
+    for (int frame = 0; frame < 100; frame++) {
+        mousekey_motion_update(&motion, &curve, 0, 10);
+        x += mousekey_motion_take(&motion, 0, 127);
+        y += mousekey_motion_take(&motion, 1, 127);
+    }
+    EXPECT_NEAR(x, -848, 1);
+    EXPECT_NEAR(y, 7, 1);
+
+    // the scale outlives the motion
+    mousekey_motion_release(&motion, 0, -1);
+    mousekey_motion_release(&motion, 1, 1);
+    mousekey_motion_update(&motion, &curve, 0, 10);
+    EXPECT_FALSE(mousekey_motion_active(&motion));
+    EXPECT_EQ(motion.scale[0], 120);
+}
@@ -0,0 +1,6 @@
+mousekey_physics_DEFS := -DNO_DEBUG
+mousekey_physics_INC := $(QUANTUM_PATH)/mousekey
+
+mousekey_physics_SRC := \
+	$(QUANTUM_PATH)/mousekey/tests/mousekey_physics_tests.cpp \
+	$(QUANTUM_PATH)/mousekey/mousekey_physics.c
@@ -25,15 +25,50 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 static report_mouse_t mouseReport = {};
 
+// Motion and scrolling not sent yet, in 1/POINTING_DEVICE_SUBCOUNTS of a report count
+static int32_t pending_x, pending_y, pending_v, pending_h;
+
 __attribute__((weak)) bool has_mouse_report_changed(report_mouse_t new, report_mouse_t old) { return (new.buttons != old.buttons) || (new.x&& new.x != old.x) || (new.y&& new.y != old.y) || (new.h&& new.h != old.h) || (new.v&& new.v != old.v); }
 
 __attribute__((weak)) void pointing_device_init(void) {
     // initialize device, if that needs to be done.
 }
 
+void pointing_device_accumulate_motion(int32_t x, int32_t y) {
+    pending_x += x;
+    pending_y += y;
+}
+
+void pointing_device_accumulate_scroll(int32_t v, int32_t h) {
+#ifdef MOUSE_HIRES_SCROLL
+    // a report count is a fraction of a detent, when the host enabled high resolution scrolling
+    if (mouse_resolution_report.v) v *= MOUSE_HIRES_SCROLL_MULTIPLIER;
+    if (mouse_resolution_report.h) h *= MOUSE_HIRES_SCROLL_MULTIPLIER;
+#endif
+    pending_v += v;
+    pending_h += h;
+}
+
+/* Takes the whole counts that fit in a report, leaving the rest for the next one */
+static int32_t take_counts(int32_t *pending, int32_t limit) {
+    int32_t counts = *pending / POINTING_DEVICE_SUBCOUNTS;
+    if (counts > limit) counts = limit;
+    if (counts < -limit) counts = -limit;
+    *pending -= counts * POINTING_DEVICE_SUBCOUNTS;
+    return counts;
+}
+
 __attribute__((weak)) void pointing_device_send(void) {
     static report_mouse_t old_report = {};
 
+    // Counts set directly in the report go along with the accumulated ones
+    pointing_device_accumulate_motion((int32_t)mouseReport.x * POINTING_DEVICE_SUBCOUNTS, (int32_t)mouseReport.y * POINTING_DEVICE_SUBCOUNTS);
+    pointing_device_accumulate_scroll((int32_t)mouseReport.v * POINTING_DEVICE_SUBCOUNTS, (int32_t)mouseReport.h * POINTING_DEVICE_SUBCOUNTS);
+    mouseReport.x = take_counts(&pending_x, MOUSE_REPORT_XY_MAX);
+    mouseReport.y = take_counts(&pending_y, MOUSE_REPORT_XY_MAX);
+    mouseReport.v = take_counts(&pending_v, 127);
+    mouseReport.h = take_counts(&pending_h, 127);
+
     // If you need to do other things, like debugging, this is the place to do it.
     if (has_mouse_report_changed(mouseReport, old_report)) {
         host_mouse_send(&mouseReport);
@@ -48,8 +83,8 @@ __attribute__((weak)) void pointing_device_send(void) {
 
 __attribute__((weak)) void pointing_device_task(void) {
     // gather info and put it in:
-    // mouseReport.x = 127 max -127 min
-    // mouseReport.y = 127 max -127 min
+    // mouseReport.x = 127 max -127 min (32767 max -32767 min with MOUSE_EXTENDED_REPORT)
+    // mouseReport.y = 127 max -127 min (32767 max -32767 min with MOUSE_EXTENDED_REPORT)
     // mouseReport.v = 127 max -127 min (scroll vertical)
     // mouseReport.h = 127 max -127 min (scroll horizontal)
     // mouseReport.buttons = 0x1F (decimal 31, binary 00011111) max (bitmask for mouse buttons 1-5, 1 is rightmost, 5 is leftmost) 0x00 min
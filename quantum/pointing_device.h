@@ -21,9 +21,27 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "report.h"
 
+#ifndef POINTING_DEVICE_SUBCOUNTS
+#    define POINTING_DEVICE_SUBCOUNTS 256
+#endif
+
 void           pointing_device_init(void);
 void           pointing_device_task(void);
 void           pointing_device_send(void);
 report_mouse_t pointing_device_get_report(void);
 void           pointing_device_set_report(report_mouse_t newMouseReport);
 bool           has_mouse_report_changed(report_mouse_t new, report_mouse_t old);
+
+/**
+ * Adds motion to the next reports, in 1/POINTING_DEVICE_SUBCOUNTS of a count.
+ *
+ * Fractions of a count, and counts beyond what a report can hold, carry over to the next reports instead of being lost.
+ */
+void pointing_device_accumulate_motion(int32_t x, int32_t y);
+
+/**
+ * Adds scrolling to the next reports, in 1/POINTING_DEVICE_SUBCOUNTS of a wheel detent.
+ *
+ * With MOUSE_HIRES_SCROLL, the host can get it in finer steps than whole detents.
+ */
+void pointing_device_accumulate_scroll(int32_t v, int32_t h);
@@ -34,6 +34,26 @@ uint16_t leader_time = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#    ifdef LEADER_TRIE_ENABLE
+__attribute__((weak)) void leader_action_user(uint16_t action) {}
+
+static uint16_t leader_trie_node = LEADER_TRIE_ROOT;
+
+static void leader_trie_finish(uint16_t action) {
+    leading = false;
+    if (action != LEADER_TRIE_NO_ACTION) {
+        leader_action_user(action);
+    }
+    leader_end();
+}
+
+void leader_task(void) {
+    if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT) {
+        leader_trie_finish(leader_trie_action(leader_trie_data, leader_trie_node));
+    }
+}
+#    endif
+
 void qk_leader_start(void) {
     if (leading) {
         return;
@@ -43,6 +63,9 @@ void qk_leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#    ifdef LEADER_TRIE_ENABLE
+    leader_trie_node = LEADER_TRIE_ROOT;
+#    endif
 }
 
 bool process_leader(uint16_t keycode, keyrecord_t *record) {
@@ -55,6 +78,27 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                     keycode = keycode & 0xFF;
                 }
 #    endif  // LEADER_KEY_STRICT_KEY_PROCESSING
+#    ifdef LEADER_PER_KEY_TIMING
+                leader_time = timer_read();
+#    endif
+#    ifdef LEADER_TRIE_ENABLE
+                // The trie has no length limit, leader_sequence only keeps the first keys
+                if (leader_sequence_size < (sizeof(leader_sequence) / sizeof(leader_sequence[0]))) {
+                    leader_sequence[leader_sequence_size] = keycode;
+                    leader_sequence_size++;
+                }
+                switch (leader_trie_step(leader_trie_data, &leader_trie_node, keycode)) {
+                    case LEADER_TRIE_NO_MATCH:
+                        leader_trie_finish(LEADER_TRIE_NO_ACTION);
+                        break;
+                    case LEADER_TRIE_COMPLETE:
+                        // Nothing else can follow, so don't wait for the timeout
+                        leader_trie_finish(leader_trie_action(leader_trie_data, leader_trie_node));
+                        break;
+                    default:
+                        break;
+                }
+#    else
                 if (leader_sequence_size < (sizeof(leader_sequence) / sizeof(leader_sequence[0]))) {
                     leader_sequence[leader_sequence_size] = keycode;
                     leader_sequence_size++;
@@ -62,8 +106,6 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                     leading = false;
                     leader_end();
                 }
-#    ifdef LEADER_PER_KEY_TIMING
-                leader_time = timer_read();
 #    endif
                 return false;
             }
@@ -24,6 +24,16 @@ void leader_start(void);
 void leader_end(void);
 void qk_leader_start(void);
 
+#ifdef LEADER_TRIE_ENABLE
+#    include "leader_trie.h"
+
+/* Defined in the leader_sequences.h generated by `qmk generate-leader-trie`, included from keymap.c. */
+extern const uint16_t leader_trie_data[] PROGMEM;
+
+void leader_task(void);
+void leader_action_user(uint16_t action);
+#endif
+
 #define SEQ_ONE_KEY(key) if (leader_sequence[0] == (key) && leader_sequence[1] == 0 && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
 #define SEQ_TWO_KEYS(key1, key2) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
 #define SEQ_THREE_KEYS(key1, key2, key3) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == 0 && leader_sequence[4] == 0)
@@ -20,6 +20,15 @@
 #include "virtser.h"
 #include <string.h>
 
+#ifdef STENO_RAW_HID
+#    ifndef RAW_ENABLE
+#        error "STENO_RAW_HID requires RAW_ENABLE"
+#    endif
+#    include "raw_hid.h"
+#    include "timer.h"
+#    include "usb_descriptor.h"
+#endif
+
 // TxBolt Codes
 #define TXB_NUL 0
 #define TXB_S_L 0b00000001
@@ -70,14 +79,39 @@ static void steno_clear_state(void) {
     memset(chord, 0, sizeof(chord));
 }
 
-static void send_steno_state(uint8_t size, bool send_empty) {
+/* Packs the chord into a complete packet, so that it is handed to the USB stack in one go. */
+static void send_steno_state(uint8_t size, bool send_empty, bool terminate) {
+#ifdef STENO_RAW_HID
+    uint8_t  packet[RAW_EPSIZE] = {STENO_RAW_HID_PACKET_ID, mode};
+    uint32_t now                = timer_read32();
+    uint8_t  length             = STENO_RAW_HID_HEADER_SIZE;
+
+    packet[2] = now & 0xFF;
+    packet[3] = (now >> 8) & 0xFF;
+    packet[4] = (now >> 16) & 0xFF;
+    packet[5] = (now >> 24) & 0xFF;
+#else
+    uint8_t packet[MAX_STATE_SIZE + 1];
+    uint8_t length = 0;
+#endif
+
     for (uint8_t i = 0; i < size; ++i) {
         if (chord[i] || send_empty) {
-#ifdef VIRTSER_ENABLE
-            virtser_send(chord[i]);
-#endif
+            packet[length++] = chord[i];
         }
     }
+    if (terminate) {
+        packet[length++] = 0;
+    }
+
+#ifdef STENO_RAW_HID
+    packet[6] = length - STENO_RAW_HID_HEADER_SIZE;
+    raw_hid_send(packet, sizeof(packet));
+#elif defined(VIRTSER_ENABLE)
+    virtser_send_buffer(packet, length);
+#else
+    (void)packet;
+#endif
 }
 
 void steno_init() {
@@ -106,14 +140,11 @@ static void send_steno_chord(void) {
     if (send_steno_chord_user(mode, chord)) {
         switch (mode) {
             case STENO_MODE_BOLT:
-                send_steno_state(BOLT_STATE_SIZE, false);
-#ifdef VIRTSER_ENABLE
-                virtser_send(0);  // terminating byte
-#endif
+                send_steno_state(BOLT_STATE_SIZE, false, true);  // with terminating byte
                 break;
             case STENO_MODE_GEMINI:
                 chord[0] |= 0x80;  // Indicate start of packet
-                send_steno_state(GEMINI_STATE_SIZE, true);
+                send_steno_state(GEMINI_STATE_SIZE, true, false);
                 break;
         }
     }
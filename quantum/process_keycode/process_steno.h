@@ -20,6 +20,17 @@
 
 typedef enum { STENO_MODE_BOLT, STENO_MODE_GEMINI } steno_mode_t;
 
+#ifdef STENO_RAW_HID
+/* Raw HID chord report:
+ * [packet id, mode, timestamp (4 bytes, ms, little endian), length, chord bytes...]
+ * The chord bytes are the TX Bolt or GeminiPR packet that would have been sent over the serial port.
+ */
+#    ifndef STENO_RAW_HID_PACKET_ID
+#        define STENO_RAW_HID_PACKET_ID 0x53
+#    endif
+#    define STENO_RAW_HID_HEADER_SIZE 7
+#endif
+
 bool     process_steno(uint16_t keycode, keyrecord_t *record);
 void     steno_init(void);
 void     steno_set_mode(steno_mode_t mode);
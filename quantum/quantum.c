@@ -410,6 +410,10 @@ void matrix_scan_quantum() {
     matrix_scan_tap_dance();
 #endif
 
+#if defined(LEADER_ENABLE) && defined(LEADER_TRIE_ENABLE)
+    leader_task();
+#endif
+
 #ifdef COMBO_ENABLE
     matrix_scan_combo();
 #endif
@@ -136,6 +136,26 @@ static rgb_task_states rgb_task_state    = SYNCING;
 #if RGB_DISABLE_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif  // RGB_DISABLE_TIMEOUT > 0
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    ifndef RGB_MATRIX_RENDER_REPORT_INTERVAL
+#        define RGB_MATRIX_RENDER_REPORT_INTERVAL 1000
+#    endif
+uint8_t         rgb_matrix_led_process_limit = RGB_MATRIX_LED_PROCESS_LIMIT;
+static uint16_t rgb_render_cost[RGB_MATRIX_EFFECT_MAX];  // render time per LED of each effect, in 1/16 us
+static uint16_t rgb_render_indicators_us;                  // time the indicator callbacks take per slice
+static uint32_t rgb_render_frame_us;                       // render time of the current frame, indicators included
+static uint32_t rgb_render_last_frame_us;
+static uint16_t rgb_render_frames;
+static uint16_t rgb_render_report_timer;
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
+#ifdef RGB_MATRIX_LAYER_INDICATORS
+#    define RGB_LAYER_INDICATOR_NONE UINT8_MAX
+static uint8_t       rgb_indicator_layer[DRIVER_LED_TOTAL];  // layer lighting each LED, or RGB_LAYER_INDICATOR_NONE
+static RGB           rgb_indicator_color[MAX_LAYER];
+static layer_state_t rgb_indicator_layer_state;
+static uint8_t       rgb_indicator_val;
+static bool          rgb_indicator_dirty = true;
+#endif  // RGB_MATRIX_LAYER_INDICATORS
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -298,9 +318,121 @@ static void rgb_task_sync(void) {
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
-static void rgb_task_start(void) {
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static void rgb_render_budget_start(uint8_t effect) {
+    uint32_t limit = RGB_MATRIX_LED_PROCESS_LIMIT;
+    if (effect < RGB_MATRIX_EFFECT_MAX && rgb_render_cost[effect]) {
+        // the indicators run after every slice, so they take their share of the budget first
+        uint32_t budget = RGB_MATRIX_RENDER_BUDGET_US > rgb_render_indicators_us ? RGB_MATRIX_RENDER_BUDGET_US - rgb_render_indicators_us : 0;
+        limit           = budget * 16 / rgb_render_cost[effect];
+    }
+
+    // heavy effects end up one LED per task run, at a lower frame rate
+    if (limit < 1) limit = 1;
+    if (limit > DRIVER_LED_TOTAL) limit = DRIVER_LED_TOTAL;
+    rgb_matrix_led_process_limit = limit;
+    rgb_render_frame_us          = 0;
+}
+
+static void rgb_render_budget_update(uint8_t effect, uint32_t effect_us, uint32_t indicators_us) {
+    rgb_render_frame_us += effect_us + indicators_us;
+    if (effect >= RGB_MATRIX_EFFECT_MAX || rgb_effect_params.init) {
+        // init passes do extra work which should not count towards the per LED cost
+        return;
+    }
+
+    // LEDs in the slice that was just rendered
+    uint8_t min = rgb_matrix_led_process_limit * (rgb_effect_params.iter - 1);
+    uint8_t max = min + rgb_matrix_led_process_limit;
+    if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
+    if (max <= min) return;
+
+    if (indicators_us > UINT16_MAX) indicators_us = UINT16_MAX;
+    rgb_render_indicators_us = (rgb_render_indicators_us * 3 + indicators_us) / 4;
+
+    // only the effect counts towards its per LED cost, not the indicator callbacks
+    uint32_t cost = effect_us * 16 / (max - min);
+    if (cost > UINT16_MAX) cost = UINT16_MAX;
+    if (cost == 0) cost = 1;
+
+    // exponential moving average, so that a single interrupted slice does not throw the budget off
+    if (rgb_render_cost[effect]) {
+        cost = (rgb_render_cost[effect] * 3 + cost) / 4;
+    }
+    rgb_render_cost[effect] = cost;
+}
+
+static void rgb_render_budget_report(uint8_t effect) {
+    rgb_render_frames++;
+    rgb_render_last_frame_us = rgb_render_frame_us;
+    if (timer_elapsed(rgb_render_report_timer) < RGB_MATRIX_RENDER_REPORT_INTERVAL) return;
+
+    uint16_t cost = effect < RGB_MATRIX_EFFECT_MAX ? rgb_render_cost[effect] : 0;
+    dprintf("rgb_matrix effect %u: %lu us/frame, %u.%02u us/LED, %u us/slice indicators, %u LEDs/slice, %u frames\n", effect, (unsigned long)rgb_render_last_frame_us, cost / 16, (cost % 16) * 100 / 16, rgb_render_indicators_us, rgb_matrix_led_process_limit, rgb_render_frames);
+    rgb_render_frames       = 0;
+    rgb_render_report_timer = timer_read();
+}
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
+
+#ifdef RGB_MATRIX_LAYER_INDICATORS
+__attribute__((weak)) HSV rgb_matrix_layer_indicator_kb(uint8_t layer) { return rgb_matrix_layer_indicator_user(layer); }
+
+__attribute__((weak)) HSV rgb_matrix_layer_indicator_user(uint8_t layer) { return (HSV){0, 0, 0}; }
+
+void rgb_matrix_layer_indicators_refresh(void) { rgb_indicator_dirty = true; }
+
+// Works out which layer lights each LED. Walking the keymap is too slow to do for
+// every frame, so this only runs when the layers, the default layer, the brightness or the keymap change.
+static void rgb_layer_indicators_update(void) {
+    // keys are looked up in the default layers too, so they are part of the state
+    layer_state_t state = layer_state | default_layer_state;
+    if (!rgb_indicator_dirty && state == rgb_indicator_layer_state && rgb_matrix_config.hsv.v == rgb_indicator_val) return;
+    rgb_indicator_dirty       = false;
+    rgb_indicator_layer_state = state;
+    rgb_indicator_val         = rgb_matrix_config.hsv.v;
+
+    memset(rgb_indicator_layer, RGB_LAYER_INDICATOR_NONE, sizeof(rgb_indicator_layer));
+
+    layer_state_t lit_layers = 0;
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        if (!(state & ((layer_state_t)1 << layer))) continue;
+        HSV hsv = rgb_matrix_layer_indicator_kb(layer);
+        if (hsv.v == 0) continue;
+        hsv.v                      = scale8(hsv.v, rgb_indicator_val);
+        rgb_indicator_color[layer] = rgb_matrix_hsv_to_rgb(hsv);
+        lit_layers |= (layer_state_t)1 << layer;
+    }
+    if (!lit_layers) return;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led == NO_LED) continue;
+
+            // the highest active layer with a non-transparent key owns it, the same way keys are looked up
+            for (int8_t layer = get_highest_layer(state); layer >= 0; layer--) {
+                if (!(state & ((layer_state_t)1 << layer))) continue;
+                uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){.row = row, .col = col});
+                if (keycode == KC_TRANSPARENT) continue;
+                if (keycode != KC_NO && (lit_layers & ((layer_state_t)1 << layer))) {
+                    rgb_indicator_layer[led] = layer;
+                }
+                break;
+            }
+        }
+    }
+}
+#endif  // RGB_MATRIX_LAYER_INDICATORS
+
+static void rgb_task_start(uint8_t effect) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_budget_start(effect);
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
+#ifdef RGB_MATRIX_LAYER_INDICATORS
+    rgb_layer_indicators_update();
+#endif  // RGB_MATRIX_LAYER_INDICATORS
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -376,6 +508,10 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_budget_report(effect);
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -398,15 +534,24 @@ void rgb_matrix_task(void) {
 
     switch (rgb_task_state) {
         case STARTING:
-            rgb_task_start();
+            rgb_task_start(effect);
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            uint32_t render_start = timer_read_us32();
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
             rgb_task_render(effect);
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            uint32_t indicators_start = timer_read_us32();
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
             if (effect) {
                 rgb_matrix_indicators();
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
-            break;
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            rgb_render_budget_update(effect, indicators_start - render_start, timer_elapsed_us32(indicators_start));
+#endif  // RGB_MATRIX_RENDER_BUDGET_US
+        } break;
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -431,14 +576,22 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      * and not sure which would be better. Otherwise, this should be called from
      * rgb_task_render, right before the iter++ line.
      */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-    uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
-    uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
+#if defined(RGB_MATRIX_RENDER_BUDGET_US) || (defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL)
+    uint8_t min = RGB_MATRIX_LED_SLICE * (params->iter - 1);
+    uint8_t max = min + RGB_MATRIX_LED_SLICE;
     if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
 #else
     uint8_t min = 0;
     uint8_t max = DRIVER_LED_TOTAL;
 #endif
+#ifdef RGB_MATRIX_LAYER_INDICATORS
+    for (uint8_t i = min; i < max; i++) {
+        uint8_t layer = rgb_indicator_layer[i];
+        if (layer != RGB_LAYER_INDICATOR_NONE) {
+            rgb_matrix_set_color(i, rgb_indicator_color[layer].r, rgb_indicator_color[layer].g, rgb_indicator_color[layer].b);
+        }
+    }
+#endif  // RGB_MATRIX_LAYER_INDICATORS
     rgb_matrix_indicators_advanced_kb(min, max);
     rgb_matrix_indicators_advanced_user(min, max);
 }
@@ -45,10 +45,18 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
-#    define RGB_MATRIX_USE_LIMITS(min, max)                        \
-        uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
-        uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+// Slice size picked at the start of each frame to fit the budget, from the measured cost of the effect
+extern uint8_t rgb_matrix_led_process_limit;
+#    define RGB_MATRIX_LED_SLICE rgb_matrix_led_process_limit
+#else
+#    define RGB_MATRIX_LED_SLICE (RGB_MATRIX_LED_PROCESS_LIMIT)
+#endif
+
+#if defined(RGB_MATRIX_RENDER_BUDGET_US) || (defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL)
+#    define RGB_MATRIX_USE_LIMITS(min, max)                \
+        uint8_t min = RGB_MATRIX_LED_SLICE * params->iter; \
+        uint8_t max = min + RGB_MATRIX_LED_SLICE;          \
         if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
 #else
 #    define RGB_MATRIX_USE_LIMITS(min, max) \
@@ -112,6 +120,13 @@ void rgb_matrix_indicators_advanced(effect_params_t *params);
 void rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
+#ifdef RGB_MATRIX_LAYER_INDICATORS
+// Color of the keys of a layer, drawn over the effect; a value of 0 means no indicator
+HSV  rgb_matrix_layer_indicator_kb(uint8_t layer);
+HSV  rgb_matrix_layer_indicator_user(uint8_t layer);
+void rgb_matrix_layer_indicators_refresh(void);
+#endif
+
 void rgb_matrix_init(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -138,9 +138,17 @@ rgblight_segment_t const *const *rgblight_layers = NULL;
 
 rgblight_ranges_t rgblight_ranges = {0, RGBLED_NUM, 0, RGBLED_NUM, RGBLED_NUM};
 
+#ifdef RGBLIGHT_DEFERRED_SET
+static bool rgblight_dirty      = false;
+static bool rgblight_sent_valid = false;
+#endif
+
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.clipping_start_pos = start_pos;
     rgblight_ranges.clipping_num_leds  = num_leds;
+#ifdef RGBLIGHT_DEFERRED_SET
+    rgblight_sent_valid = false;
+#endif
 }
 
 void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
@@ -642,7 +650,9 @@ void rgblight_setrgb_range(uint8_t r, uint8_t g, uint8_t b, uint8_t start, uint8
 #endif
     }
     rgblight_set();
+#ifndef RGBLIGHT_DEFERRED_SET
     wait_ms(1);
+#endif
 }
 
 void rgblight_sethsv_range(uint8_t hue, uint8_t sat, uint8_t val, uint8_t start, uint8_t end) {
@@ -760,11 +770,16 @@ void rgblight_suspend(void) {
 #    endif
 
         rgblight_disable_noeeprom();
+        rgblight_flush();
     }
 }
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+#    ifdef RGBLIGHT_DEFERRED_SET
+    // the LEDs may have lost power while suspended
+    rgblight_sent_valid = false;
+#    endif
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -777,6 +792,7 @@ void rgblight_wakeup(void) {
 #    endif
 
     rgblight_timer_enable();
+    rgblight_flush();
 }
 
 #endif
@@ -785,7 +801,30 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
 
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
-void rgblight_set(void) {
+#    ifdef RGBLIGHT_DEFERRED_SET
+/* Sends only the LEDs up to the last one that differs from the previous frame.
+ * The LEDs are daisy chained, so the ones further down keep their colors. */
+static void rgblight_call_driver_changed(LED_TYPE *start_led, uint8_t num_leds) {
+    static LED_TYPE led_sent[RGBLED_NUM];
+    LED_TYPE *      sent    = led_sent + rgblight_ranges.clipping_start_pos;
+    uint8_t         changed = num_leds;
+
+    if (rgblight_sent_valid) {
+        while (changed > 0 && memcmp(&start_led[changed - 1], &sent[changed - 1], sizeof(LED_TYPE)) == 0) {
+            changed--;
+        }
+        if (changed == 0) {
+            return;
+        }
+    }
+
+    memcpy(sent, start_led, changed * sizeof(LED_TYPE));
+    rgblight_sent_valid = true;
+    rgblight_call_driver(start_led, changed);
+}
+#    endif
+
+static void rgblight_write(void) {
     LED_TYPE *start_led;
     uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
 
@@ -827,8 +866,25 @@ void rgblight_set(void) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
 #    endif
+#    ifdef RGBLIGHT_DEFERRED_SET
+    rgblight_call_driver_changed(start_led, num_leds);
+#    else
     rgblight_call_driver(start_led, num_leds);
+#    endif
+}
+
+#    ifdef RGBLIGHT_DEFERRED_SET
+void rgblight_set(void) { rgblight_dirty = true; }
+
+void rgblight_flush(void) {
+    if (rgblight_dirty) {
+        rgblight_dirty = false;
+        rgblight_write();
+    }
 }
+#    else
+void rgblight_set(void) { rgblight_write(); }
+#    endif
 #endif
 
 #ifdef RGBLIGHT_SPLIT
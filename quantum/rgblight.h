@@ -103,6 +103,10 @@
 
 // clang-format on
 
+#if defined(RGBLIGHT_DEFERRED_SET) && defined(RGBLIGHT_CUSTOM_DRIVER)
+#    error "RGBLIGHT_DEFERRED_SET cannot be used with RGBLIGHT_CUSTOM_DRIVER"
+#endif
+
 #define _RGBM_SINGLE_STATIC(sym) RGBLIGHT_MODE_##sym,
 #define _RGBM_SINGLE_DYNAMIC(sym) RGBLIGHT_MODE_##sym,
 #define _RGBM_MULTI_STATIC(sym) RGBLIGHT_MODE_##sym,
@@ -285,6 +289,11 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, LED_TYPE *led1);
 /* === Low level Functions === */
 void rgblight_set(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
+#    ifdef RGBLIGHT_DEFERRED_SET
+void rgblight_flush(void);
+#    else
+#        define rgblight_flush()
+#    endif
 
 /* === Effects and Animations Functions === */
 /*   effect range setting */
@@ -20,6 +20,10 @@
 
 #include "send_string.h"
 
+#ifdef UNICODE_COMMON_ENABLE
+#    include "process_unicode_common.h"
+#endif
+
 // clang-format off
 
 /* Bit-Packed look-up table to convert an ASCII character to whether
@@ -134,84 +138,74 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
-void send_string(const char *str) { send_string_with_delay(str, 0); }
+#ifdef UNICODE_COMMON_ENABLE
+// Decodes the rest of a UTF-8 sequence from the getter and sends it as a unicode code point
+static void send_string_utf8(uint8_t lead, char (*getter)(void *), void *arg) {
+    uint32_t code_point;
+    uint8_t  continuation;
 
-void send_string_P(const char *str) { send_string_with_delay_P(str, 0); }
+    if ((lead & 0xE0) == 0xC0) {  // U+0080-07FF
+        code_point   = lead & 0x1F;
+        continuation = 1;
+    } else if ((lead & 0xF0) == 0xE0) {  // U+0800-FFFF
+        code_point   = lead & 0x0F;
+        continuation = 2;
+    } else if ((lead & 0xF8) == 0xF0 && lead <= 0xF4) {  // U+10000-10FFFF
+        code_point   = lead & 0x07;
+        continuation = 3;
+    } else {
+        return;
+    }
 
-void send_string_with_delay(const char *str, uint8_t interval) {
-    while (1) {
-        char ascii_code = *str;
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = *(++str);
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = *(++str);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = *(++str);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = *(++str);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int     ms      = 0;
-                uint8_t keycode = *(++str);
-                while (isdigit(keycode)) {
-                    ms *= 10;
-                    ms += keycode - '0';
-                    keycode = *(++str);
-                }
-                while (ms--) wait_ms(1);
-            }
-        } else {
-            send_char(ascii_code);
-        }
-        ++str;
-        // interval
-        {
-            uint8_t ms = interval;
-            while (ms--) wait_ms(1);
-        }
+    while (continuation--) {
+        uint8_t byte = getter(arg);
+        if ((byte & 0xC0) != 0x80) return;
+        code_point = (code_point << 6) | (byte & 0x3F);
     }
+
+    // part of a UTF-16 surrogate pair - invalid
+    if (code_point >= 0xD800 && code_point <= 0xDFFF) return;
+
+    register_unicode(code_point);
 }
+#endif
 
-void send_string_with_delay_P(const char *str, uint8_t interval) {
+void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
     while (1) {
-        char ascii_code = pgm_read_byte(str);
+        char ascii_code = getter(arg);
         if (!ascii_code) break;
         if (ascii_code == SS_QMK_PREFIX) {
-            ascii_code = pgm_read_byte(++str);
+            ascii_code = getter(arg);
             if (ascii_code == SS_TAP_CODE) {
                 // tap
-                uint8_t keycode = pgm_read_byte(++str);
+                uint8_t keycode = getter(arg);
                 tap_code(keycode);
             } else if (ascii_code == SS_DOWN_CODE) {
                 // down
-                uint8_t keycode = pgm_read_byte(++str);
+                uint8_t keycode = getter(arg);
                 register_code(keycode);
             } else if (ascii_code == SS_UP_CODE) {
                 // up
-                uint8_t keycode = pgm_read_byte(++str);
+                uint8_t keycode = getter(arg);
                 unregister_code(keycode);
             } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
+                // delay, the terminator after the digits is consumed here
                 int     ms      = 0;
-                uint8_t keycode = pgm_read_byte(++str);
+                uint8_t keycode = getter(arg);
                 while (isdigit(keycode)) {
                     ms *= 10;
                     ms += keycode - '0';
-                    keycode = pgm_read_byte(++str);
+                    keycode = getter(arg);
                 }
                 while (ms--) wait_ms(1);
             }
-        } else {
+        } else if ((uint8_t)ascii_code < 0x80) {
             send_char(ascii_code);
+#ifdef UNICODE_COMMON_ENABLE
+        } else {
+            send_string_utf8(ascii_code, getter, arg);
+#endif
         }
-        ++str;
         // interval
         {
             uint8_t ms = interval;
@@ -220,6 +214,30 @@ void send_string_with_delay_P(const char *str, uint8_t interval) {
     }
 }
 
+// Getters stay on the null terminator once they reach it, so that a truncated escape sequence
+// still ends the string.
+static char send_string_get_next_ram(void *arg) {
+    const char **str = (const char **)arg;
+    char         ret = **str;
+    if (ret) (*str)++;
+    return ret;
+}
+
+static char send_string_get_next_progmem(void *arg) {
+    const char **str = (const char **)arg;
+    char         ret = pgm_read_byte(*str);
+    if (ret) (*str)++;
+    return ret;
+}
+
+void send_string(const char *str) { send_string_with_delay(str, 0); }
+
+void send_string_P(const char *str) { send_string_with_delay_P(str, 0); }
+
+void send_string_with_delay(const char *str, uint8_t interval) { send_string_with_delay_impl(send_string_get_next_ram, &str, interval); }
+
+void send_string_with_delay_P(const char *str, uint8_t interval) { send_string_with_delay_impl(send_string_get_next_progmem, &str, interval); }
+
 void send_char(char ascii_code) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') {  // BEL
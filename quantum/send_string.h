@@ -44,6 +44,9 @@ void send_string(const char *str);
 void send_string_with_delay(const char *str, uint8_t interval);
 void send_string_P(const char *str);
 void send_string_with_delay_P(const char *str, uint8_t interval);
+// Sends the string produced by getter one byte at a time, for strings that are not contiguous in
+// RAM or flash. The getter returns 0 at the end of the string, and keeps returning 0 after that.
+void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
 void send_char(char ascii_code);
 
 void send_dword(uint32_t number);
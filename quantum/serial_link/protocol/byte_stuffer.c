@@ -24,8 +24,10 @@ SOFTWARE.
 
 #include "serial_link/protocol/byte_stuffer.h"
 #include "serial_link/protocol/frame_validator.h"
+#include "serial_link/protocol/frame_router.h"
 #include "serial_link/protocol/physical.h"
 #include <stdbool.h>
+#include <string.h>
 
 // This implements the "Consistent overhead byte stuffing protocol"
 // https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing
@@ -35,15 +37,37 @@ typedef struct byte_stuffer_state {
     uint16_t next_zero;
     uint16_t data_pos;
     bool     long_frame;
+    // Where the frame is decoded, data until its header tells where it goes
+    uint8_t* frame;
+    uint16_t frame_size;
     uint8_t  data[MAX_FRAME_SIZE];
 } byte_stuffer_state_t;
 
 static byte_stuffer_state_t states[NUM_LINKS];
 
-void init_byte_stuffer_state(byte_stuffer_state_t* state) {
-    state->next_zero  = 0;
+static void start_frame(byte_stuffer_state_t* state, uint8_t next_zero) {
+    state->next_zero  = next_zero;
+    state->long_frame = next_zero == 0xFF;
     state->data_pos   = 0;
-    state->long_frame = false;
+    state->frame      = state->data;
+    state->frame_size = MAX_FRAME_SIZE;
+}
+
+void init_byte_stuffer_state(byte_stuffer_state_t* state) { start_frame(state, 0); }
+
+static void store_byte(uint8_t link, byte_stuffer_state_t* state, uint8_t data) {
+    state->frame[state->data_pos++] = data;
+
+    // Once the header is known the rest of the frame is decoded where it's used, instead of being copied there after
+    if (state->data_pos == FRAME_HEADER_SIZE && state->frame == state->data) {
+        uint16_t capacity;
+        uint8_t* buffer = validator_recv_buffer(link, state->data, &capacity);
+        if (buffer) {
+            memcpy(buffer, state->data, FRAME_HEADER_SIZE);
+            state->frame      = buffer;
+            state->frame_size = capacity;
+        }
+    }
 }
 
 void init_byte_stuffer(void) {
@@ -57,9 +81,7 @@ void byte_stuffer_recv_byte(uint8_t link, uint8_t data) {
     byte_stuffer_state_t* state = &states[link];
     // Start of a new frame
     if (state->next_zero == 0) {
-        state->next_zero  = data;
-        state->long_frame = data == 0xFF;
-        state->data_pos   = 0;
+        start_frame(state, data);
         return;
     }
 
@@ -68,19 +90,17 @@ void byte_stuffer_recv_byte(uint8_t link, uint8_t data) {
         if (state->next_zero == 0) {
             // The frame is completed
             if (state->data_pos > 0) {
-                validator_recv_frame(link, state->data, state->data_pos);
+                validator_recv_frame(link, state->frame, state->data_pos);
             }
         } else {
             // The frame is invalid, so reset
             init_byte_stuffer_state(state);
         }
     } else {
-        if (state->data_pos == MAX_FRAME_SIZE) {
+        if (state->data_pos == state->frame_size) {
             // We exceeded our maximum frame size
             // therefore there's nothing else to do than reset to a new frame
-            state->next_zero  = data;
-            state->long_frame = data == 0xFF;
-            state->data_pos   = 0;
+            start_frame(state, data);
         } else if (state->next_zero == 0) {
             if (state->long_frame) {
                 // This is part of a long frame, so continue
@@ -88,11 +108,11 @@ void byte_stuffer_recv_byte(uint8_t link, uint8_t data) {
                 state->long_frame = data == 0xFF;
             } else {
                 // Special case for zeroes
-                state->next_zero               = data;
-                state->data[state->data_pos++] = 0;
+                state->next_zero = data;
+                store_byte(link, state, 0);
             }
         } else {
-            state->data[state->data_pos++] = data;
+            store_byte(link, state, data);
         }
     }
 }
@@ -0,0 +1,41 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * The CRCs the frame validator can check frames with. All the CRC32 backends
+ * compute the same CRC as zlib, and differ in speed and size:
+ *
+ *   crc32_byte          a byte at a time, through a 1 KB table
+ *   crc32_slicing_by_4  4 bytes at a time, through 4 KB of tables
+ *   crc32_slicing_by_8  8 bytes at a time, through 8 KB of tables
+ *   crc32_stm32         the CRC unit of the STM32 MCUs that can reverse
+ *                       bits, with SERIAL_LINK_CRC_STM32 only
+ *
+ * crc16_ccitt is a CRC-16/X-25 without a table, for the smaller MCUs.
+ */
+
+uint32_t crc32_byte(const uint8_t* data, uint16_t size);
+uint32_t crc32_slicing_by_4(const uint8_t* data, uint16_t size);
+uint32_t crc32_slicing_by_8(const uint8_t* data, uint16_t size);
+#ifdef SERIAL_LINK_CRC_STM32
+uint32_t crc32_stm32(const uint8_t* data, uint16_t size);
+#endif
+uint16_t crc16_ccitt(const uint8_t* data, uint16_t size);
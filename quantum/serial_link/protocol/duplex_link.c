@@ -0,0 +1,141 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "serial_link/protocol/duplex_link.h"
+#include "serial_link/protocol/frame_validator.h"
+
+// FNV-1a, to notice changes of the target's data without keeping a copy of it
+static uint32_t hash(const uint8_t *data, uint8_t size) {
+    uint32_t h = 2166136261u;
+    while (size--) {
+        h ^= *data++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void send_frame(duplex_link_t *dl, uint8_t header, uint8_t sequence, const uint8_t *data, uint8_t size) {
+    dl->frame[0] = header;
+    dl->frame[1] = sequence;
+    if (size) {
+        memcpy(&dl->frame[2], data, size);
+    }
+    validator_send_frame(dl->link, dl->frame, 2 + size);
+    dl->stats.frames_sent++;
+}
+
+void duplex_link_init(duplex_link_t *dl, uint8_t link, SSTD_t *table, uint8_t table_size) {
+    memset(dl, 0, sizeof(duplex_link_t));
+    dl->table      = table;
+    dl->table_size = table_size < DUPLEX_LINK_MAX_TRANSACTIONS ? table_size : DUPLEX_LINK_MAX_TRANSACTIONS;
+    dl->link       = link;
+    dl->pending    = DUPLEX_LINK_NONE;
+}
+
+bool duplex_link_request(duplex_link_t *dl, uint8_t index, bool retry) {
+    if (index >= dl->table_size) {
+        return false;
+    }
+
+    if (retry && index == dl->pending) {
+        dl->stats.retries++;
+    } else {
+        dl->sequence++;
+    }
+    dl->pending  = index;
+    dl->answered = false;
+
+    SSTD_t *trans = &dl->table[index];
+    send_frame(dl, DUPLEX_LINK_REQUEST | index, dl->sequence, trans->initiator2target_buffer, trans->initiator2target_buffer_size);
+    return true;
+}
+
+bool duplex_link_answered(duplex_link_t *dl) { return dl->answered; }
+
+void duplex_link_fail(duplex_link_t *dl) {
+    if (dl->pending != DUPLEX_LINK_NONE) {
+        dl->stats.errors++;
+        dl->pending = DUPLEX_LINK_NONE;
+    }
+}
+
+void duplex_link_push(duplex_link_t *dl) {
+    for (uint8_t index = 0; index < dl->table_size; index++) {
+        SSTD_t *trans = &dl->table[index];
+        if (!trans->target2initiator_buffer_size) {
+            continue;
+        }
+
+        uint32_t h = hash(trans->target2initiator_buffer, trans->target2initiator_buffer_size);
+        if (h != dl->pushed[index]) {
+            send_frame(dl, DUPLEX_LINK_PUSH | index, 0, trans->target2initiator_buffer, trans->target2initiator_buffer_size);
+            dl->pushed[index] = h;
+        }
+    }
+}
+
+void duplex_link_recv_frame(duplex_link_t *dl, uint8_t *data, uint16_t size) {
+    if (size < 2 || (data[0] & DUPLEX_LINK_ID_MASK) >= dl->table_size) {
+        dl->stats.errors++;
+        return;
+    }
+
+    uint8_t kind     = data[0] & DUPLEX_LINK_KIND_MASK;
+    uint8_t index    = data[0] & DUPLEX_LINK_ID_MASK;
+    uint8_t sequence = data[1];
+    SSTD_t *trans    = &dl->table[index];
+    data += 2;
+    size -= 2;
+
+    switch (kind) {
+        case DUPLEX_LINK_REQUEST:
+            if (size != trans->initiator2target_buffer_size) {
+                break;
+            }
+            dl->stats.frames_received++;
+            if (size) {
+                memcpy(trans->initiator2target_buffer, data, size);
+            }
+            if (trans->status) {
+                *trans->status = TRANSACTION_ACCEPTED;
+            }
+
+            // The answer carries the target's data, so there's no need to push it after
+            send_frame(dl, DUPLEX_LINK_ANSWER | index, sequence, trans->target2initiator_buffer, trans->target2initiator_buffer_size);
+            dl->pushed[index] = hash(trans->target2initiator_buffer, trans->target2initiator_buffer_size);
+            return;
+
+        case DUPLEX_LINK_ANSWER:
+        case DUPLEX_LINK_PUSH:
+            if (size != trans->target2initiator_buffer_size) {
+                break;
+            }
+            dl->stats.frames_received++;
+            if (size) {
+                memcpy(trans->target2initiator_buffer, data, size);
+            }
+
+            // Answers to abandoned requests, or to the first try of a request sent again, still bring the latest data
+            if (kind == DUPLEX_LINK_ANSWER && index == dl->pending && sequence == dl->sequence) {
+                dl->pending  = DUPLEX_LINK_NONE;
+                dl->answered = true;
+            }
+            return;
+    }
+
+    dl->stats.errors++;
+}
@@ -0,0 +1,102 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "serial.h"
+#include "serial_link/protocol/frame_validator.h"
+
+/*
+ * Split transactions over a full duplex link, framed by the byte stuffer and
+ * checked by the frame validator. Every frame is
+ *
+ *   header    kind in bits 6-7, transaction id in bits 0-5
+ *   sequence  of the request, echoed by its answer
+ *   data      the initiator's data of the transaction for requests, the
+ *             target's data for answers and pushes
+ *
+ * The initiator sends a request and the target answers it right away. Frames
+ * that are lost or fail their CRC are made up for by sending the request
+ * again. Independently of requests, the target pushes its data whenever it
+ * changes, so the initiator usually has it before asking.
+ */
+
+#define DUPLEX_LINK_REQUEST 0x00
+#define DUPLEX_LINK_ANSWER 0x40
+#define DUPLEX_LINK_PUSH 0x80
+#define DUPLEX_LINK_KIND_MASK 0xC0
+#define DUPLEX_LINK_ID_MASK 0x3F
+
+#define DUPLEX_LINK_MAX_TRANSACTIONS (DUPLEX_LINK_ID_MASK + 1)
+#define DUPLEX_LINK_MAX_DATA 255
+
+// Space for the header, the largest data and the frame validator's CRC
+#define DUPLEX_LINK_FRAME_SIZE (2 + DUPLEX_LINK_MAX_DATA + VALIDATOR_CRC_SIZE)
+
+#define DUPLEX_LINK_NONE 0xFF
+
+typedef struct {
+    uint32_t frames_sent;
+    uint32_t frames_received;
+    uint32_t retries;  // requests sent again because their answer didn't come
+    uint32_t errors;   // requests that were never answered, and frames that fit no transaction
+} duplex_link_stats_t;
+
+typedef struct {
+    SSTD_t *            table;
+    uint8_t             table_size;
+    uint8_t             link;  // of the byte stuffer and the frame validator
+    uint8_t             pending;
+    uint8_t             sequence;
+    bool                answered;
+    uint32_t            pushed[DUPLEX_LINK_MAX_TRANSACTIONS];  // hashes of the target's data, as it was last sent
+    uint8_t             frame[DUPLEX_LINK_FRAME_SIZE];
+    duplex_link_stats_t stats;
+} duplex_link_t;
+
+void duplex_link_init(duplex_link_t *dl, uint8_t link, SSTD_t *table, uint8_t table_size);
+
+/**
+ * Initiator: sends the request of a transaction, or sends it again with
+ * `retry`. Any earlier request is abandoned.
+ *
+ * @return false for an invalid transaction id
+ */
+bool duplex_link_request(duplex_link_t *dl, uint8_t index, bool retry);
+
+/**
+ * Initiator: whether the last request was answered. The target's data is in
+ * the transaction's buffer by then.
+ */
+bool duplex_link_answered(duplex_link_t *dl);
+
+/**
+ * Initiator: gives up on the last request.
+ */
+void duplex_link_fail(duplex_link_t *dl);
+
+/**
+ * Target: pushes the data of every transaction that changed since it was last
+ * sent.
+ */
+void duplex_link_push(duplex_link_t *dl);
+
+/**
+ * Both sides: handles a frame of the link, as passed to route_incoming_frame().
+ */
+void duplex_link_recv_frame(duplex_link_t *dl, uint8_t *data, uint16_t size);
@@ -25,25 +25,48 @@ SOFTWARE.
 #include "serial_link/protocol/frame_router.h"
 #include "serial_link/protocol/transport.h"
 #include "serial_link/protocol/frame_validator.h"
+#include <stddef.h>
 
 static bool is_master;
 
 void router_set_master(bool master) { is_master = master; }
 
+// Only the frames for this keyboard are received in place, the ones passed on stay in the byte stuffer
+uint8_t* route_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity) {
+    uint8_t* buffer = NULL;
+    if (is_master) {
+        if (link == DOWN_LINK) {
+            buffer = transport_recv_buffer(header[0], header + 1, capacity);
+        }
+    } else {
+        if (link == UP_LINK && (header[0] & 1)) {
+            buffer = transport_recv_buffer(0, header + 1, capacity);
+        }
+    }
+
+    if (buffer) {
+        *capacity += 1;
+        return buffer - 1;
+    }
+    return NULL;
+}
+
 void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) {
     if (is_master) {
         if (link == DOWN_LINK) {
-            transport_recv_frame(data[size - 1], data, size - 1);
+            transport_recv_frame(data[0], data + 1, size - 1);
         }
     } else {
         if (link == UP_LINK) {
-            if (data[size - 1] & 1) {
-                transport_recv_frame(0, data, size - 1);
-            }
-            data[size - 1] >>= 1;
+            bool local = data[0] & 1;
+            data[0] >>= 1;
+            // Passed on before the transport takes the frame, which may be received in its object
             validator_send_frame(DOWN_LINK, data, size);
+            if (local) {
+                transport_recv_frame(0, data + 1, size - 1);
+            }
         } else {
-            data[size - 1]++;
+            data[0]++;
             validator_send_frame(UP_LINK, data, size);
         }
     }
@@ -52,13 +75,13 @@ void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) {
 void router_send_frame(uint8_t destination, uint8_t* data, uint16_t size) {
     if (destination == 0) {
         if (!is_master) {
-            data[size] = 1;
-            validator_send_frame(UP_LINK, data, size + 1);
+            data[-1] = 1;
+            validator_send_frame(UP_LINK, data - 1, size + 1);
         }
     } else {
         if (is_master) {
-            data[size] = destination;
-            validator_send_frame(DOWN_LINK, data, size + 1);
+            data[-1] = destination;
+            validator_send_frame(DOWN_LINK, data - 1, size + 1);
         }
     }
 }
@@ -30,6 +30,13 @@ SOFTWARE.
 #define UP_LINK 0
 #define DOWN_LINK 1
 
+// Frames start with the router's byte and the transport's object id, which
+// tell where the rest of the frame is received, see route_recv_buffer()
+#define FRAME_HEADER_SIZE 2
+
 void router_set_master(bool master);
-void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size);
+// Where to receive a frame with the given header, or NULL for the byte stuffer's own buffer
+uint8_t* route_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity);
+void     route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size);
+// The buffer pointed to by the data needs a byte before it, and VALIDATOR_CRC_SIZE bytes after it
 void router_send_frame(uint8_t destination, uint8_t* data, uint16_t size);
@@ -26,6 +26,16 @@ SOFTWARE.
 
 #include <stdint.h>
 
-void validator_recv_frame(uint8_t link, uint8_t* data, uint16_t size);
-// The buffer pointed to by the data needs 4 additional bytes
+// The CRC is chosen by defining one of SERIAL_LINK_CRC_SLICING_4, SERIAL_LINK_CRC_SLICING_8,
+// SERIAL_LINK_CRC_STM32 or SERIAL_LINK_CRC16, otherwise a byte at a time CRC32 is used
+#ifdef SERIAL_LINK_CRC16
+#    define VALIDATOR_CRC_SIZE 2
+#else
+#    define VALIDATOR_CRC_SIZE 4
+#endif
+
+// Where to receive a frame with the given header, it needs room for the CRC as well
+uint8_t* validator_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity);
+void     validator_recv_frame(uint8_t link, uint8_t* data, uint16_t size);
+// The buffer pointed to by the data needs VALIDATOR_CRC_SIZE additional bytes
 void validator_send_frame(uint8_t link, uint8_t* data, uint16_t size);
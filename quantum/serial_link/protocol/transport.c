@@ -69,23 +69,47 @@ void add_remote_objects(remote_object_t** _remote_objects, uint32_t _num_remote_
     }
 }
 
-void transport_recv_frame(uint8_t from, uint8_t* data, uint16_t size) {
-    uint8_t id = data[size - 1];
+static triple_buffer_object_t* remote_buffer(remote_object_t* obj, uint8_t from) {
+    uint8_t* start;
+    if (obj->object_type == MASTER_TO_ALL_SLAVES) {
+        start = obj->buffer + LOCAL_OBJECT_SIZE(obj->object_size);
+    } else if (obj->object_type == SLAVE_TO_MASTER) {
+        if (from < 1 || from > NUM_SLAVES) {
+            return NULL;
+        }
+        start = obj->buffer + LOCAL_OBJECT_SIZE(obj->object_size);
+        start += (from - 1) * REMOTE_OBJECT_SIZE(obj->object_size);
+    } else {
+        start = obj->buffer + NUM_SLAVES * LOCAL_OBJECT_SIZE(obj->object_size);
+    }
+    return (triple_buffer_object_t*)start;
+}
+
+// The write slot of the object, right before the object itself, so the byte stuffer decodes the frame into place
+uint8_t* transport_recv_buffer(uint8_t from, uint8_t* header, uint16_t* capacity) {
+    uint8_t id = header[0];
     if (id < num_remote_objects) {
-        remote_object_t* obj = remote_objects[id];
-        if (obj->object_size == size - 1) {
-            uint8_t* start;
-            if (obj->object_type == MASTER_TO_ALL_SLAVES) {
-                start = obj->buffer + LOCAL_OBJECT_SIZE(obj->object_size);
-            } else if (obj->object_type == SLAVE_TO_MASTER) {
-                start = obj->buffer + LOCAL_OBJECT_SIZE(obj->object_size);
-                start += (from - 1) * REMOTE_OBJECT_SIZE(obj->object_size);
-            } else {
-                start = obj->buffer + NUM_SLAVES * LOCAL_OBJECT_SIZE(obj->object_size);
+        remote_object_t*        obj = remote_objects[id];
+        triple_buffer_object_t* tb  = remote_buffer(obj, from);
+        if (tb) {
+            uint8_t* object = transport_slot_object(triple_buffer_begin_write_internal(REMOTE_SLOT_SIZE(obj->object_size), tb));
+            *capacity       = 1 + obj->object_size + REMOTE_OBJECT_EXTRA;
+            return object - 1;
+        }
+    }
+    return NULL;
+}
+
+void transport_recv_frame(uint8_t from, uint8_t* data, uint16_t size) {
+    if (size > 0 && data[0] < num_remote_objects) {
+        remote_object_t*        obj = remote_objects[data[0]];
+        triple_buffer_object_t* tb  = remote_buffer(obj, from);
+        if (tb && obj->object_size == size - 1) {
+            uint8_t* object = transport_slot_object(triple_buffer_begin_write_internal(REMOTE_SLOT_SIZE(obj->object_size), tb));
+            // Frames received through transport_recv_buffer() are already there
+            if (object != data + 1) {
+                memcpy(object, data + 1, size - 1);
             }
-            triple_buffer_object_t* tb  = (triple_buffer_object_t*)start;
-            void*                   ptr = triple_buffer_begin_write_internal(obj->object_size, tb);
-            memcpy(ptr, data, size - 1);
             triple_buffer_end_write_internal(tb);
         }
     }
@@ -97,22 +121,22 @@ void update_transport(void) {
         remote_object_t* obj = remote_objects[i];
         if (obj->object_type == MASTER_TO_ALL_SLAVES || obj->object_type == SLAVE_TO_MASTER) {
             triple_buffer_object_t* tb  = (triple_buffer_object_t*)obj->buffer;
-            uint8_t*                ptr = (uint8_t*)triple_buffer_read_internal(obj->object_size + LOCAL_OBJECT_EXTRA, tb);
+            uint8_t*                ptr = transport_slot_object(triple_buffer_read_internal(LOCAL_SLOT_SIZE(obj->object_size), tb));
             if (ptr) {
-                ptr[obj->object_size] = i;
-                uint8_t dest          = obj->object_type == MASTER_TO_ALL_SLAVES ? 0xFF : 0;
-                router_send_frame(dest, ptr, obj->object_size + 1);
+                ptr[-1]      = i;
+                uint8_t dest = obj->object_type == MASTER_TO_ALL_SLAVES ? 0xFF : 0;
+                router_send_frame(dest, ptr - 1, obj->object_size + 1);
             }
         } else {
             uint8_t*     start = obj->buffer;
             unsigned int j;
             for (j = 0; j < NUM_SLAVES; j++) {
                 triple_buffer_object_t* tb  = (triple_buffer_object_t*)start;
-                uint8_t*                ptr = (uint8_t*)triple_buffer_read_internal(obj->object_size + LOCAL_OBJECT_EXTRA, tb);
+                uint8_t*                ptr = transport_slot_object(triple_buffer_read_internal(LOCAL_SLOT_SIZE(obj->object_size), tb));
                 if (ptr) {
-                    ptr[obj->object_size] = i;
-                    uint8_t dest          = j + 1;
-                    router_send_frame(dest, ptr, obj->object_size + 1);
+                    ptr[-1]      = i;
+                    uint8_t dest = j + 1;
+                    router_send_frame(dest, ptr - 1, obj->object_size + 1);
                 }
                 start += LOCAL_OBJECT_SIZE(obj->object_size);
             }
@@ -26,9 +26,14 @@ SOFTWARE.
 
 #include "serial_link/protocol/triple_buffered_object.h"
 #include "serial_link/system/serial_link.h"
+#include <stddef.h>
 
 #define NUM_SLAVES 8
 #define LOCAL_OBJECT_EXTRA 16
+// Frames are received in place, so the slots of remote objects need room for the frame validator's CRC too
+#define REMOTE_OBJECT_EXTRA 4
+// Every slot starts with room for the frame's header, the object after it stays 4 byte aligned
+#define OBJECT_HEADER 4
 
 // master -> slave = 1 local(target all), 1 remote object
 // slave -> master = 1 local(target 0), multiple remote objects
@@ -45,8 +50,12 @@ typedef struct {
     uint8_t            buffer[] __attribute__((aligned(4)));
 } remote_object_t;
 
-#define REMOTE_OBJECT_SIZE(objectsize) (sizeof(triple_buffer_object_t) + objectsize * 3)
-#define LOCAL_OBJECT_SIZE(objectsize) (sizeof(triple_buffer_object_t) + (objectsize + LOCAL_OBJECT_EXTRA) * 3)
+#define LOCAL_SLOT_SIZE(objectsize) (OBJECT_HEADER + objectsize + LOCAL_OBJECT_EXTRA)
+#define REMOTE_SLOT_SIZE(objectsize) (OBJECT_HEADER + objectsize + REMOTE_OBJECT_EXTRA)
+#define REMOTE_OBJECT_SIZE(objectsize) (sizeof(triple_buffer_object_t) + REMOTE_SLOT_SIZE(objectsize) * 3)
+#define LOCAL_OBJECT_SIZE(objectsize) (sizeof(triple_buffer_object_t) + LOCAL_SLOT_SIZE(objectsize) * 3)
+
+static inline void* transport_slot_object(void* slot) { return slot ? (uint8_t*)slot + OBJECT_HEADER : NULL; }
 
 #define REMOTE_OBJECT_HELPER(name, type, num_local, num_remote)                                                              \
     typedef struct {                                                                                                         \
@@ -63,7 +72,7 @@ typedef struct {
     type*                    begin_write_##name(void) {                                                             \
         remote_object_t*        obj = (remote_object_t*)&remote_object_##name;                   \
         triple_buffer_object_t* tb  = (triple_buffer_object_t*)obj->buffer;                      \
-        return (type*)triple_buffer_begin_write_internal(sizeof(type) + LOCAL_OBJECT_EXTRA, tb); \
+        return (type*)transport_slot_object(triple_buffer_begin_write_internal(LOCAL_SLOT_SIZE(sizeof(type)), tb)); \
     }                                                                                                               \
     void end_write_##name(void) {                                                                                   \
         remote_object_t*        obj = (remote_object_t*)&remote_object_##name;                                      \
@@ -75,7 +84,7 @@ typedef struct {
         remote_object_t*        obj   = (remote_object_t*)&remote_object_##name;                                    \
         uint8_t*                start = obj->buffer + LOCAL_OBJECT_SIZE(obj->object_size);                          \
         triple_buffer_object_t* tb    = (triple_buffer_object_t*)start;                                             \
-        return (type*)triple_buffer_read_internal(obj->object_size, tb);                                            \
+        return (type*)transport_slot_object(triple_buffer_read_internal(REMOTE_SLOT_SIZE(obj->object_size), tb));   \
     }
 
 #define MASTER_TO_SINGLE_SLAVE_OBJECT(name, type)                                                                   \
@@ -89,7 +98,7 @@ typedef struct {
         uint8_t*         start = obj->buffer;                                                    \
         start += slave * LOCAL_OBJECT_SIZE(obj->object_size);                                    \
         triple_buffer_object_t* tb = (triple_buffer_object_t*)start;                             \
-        return (type*)triple_buffer_begin_write_internal(sizeof(type) + LOCAL_OBJECT_EXTRA, tb); \
+        return (type*)transport_slot_object(triple_buffer_begin_write_internal(LOCAL_SLOT_SIZE(sizeof(type)), tb)); \
     }                                                                                                               \
     void end_write_##name(uint8_t slave) {                                                                          \
         remote_object_t* obj   = (remote_object_t*)&remote_object_##name;                                           \
@@ -103,7 +112,7 @@ typedef struct {
         remote_object_t*        obj   = (remote_object_t*)&remote_object_##name;                                    \
         uint8_t*                start = obj->buffer + NUM_SLAVES * LOCAL_OBJECT_SIZE(obj->object_size);             \
         triple_buffer_object_t* tb    = (triple_buffer_object_t*)start;                                             \
-        return (type*)triple_buffer_read_internal(obj->object_size, tb);                                            \
+        return (type*)transport_slot_object(triple_buffer_read_internal(REMOTE_SLOT_SIZE(obj->object_size), tb));   \
     }
 
 #define SLAVE_TO_MASTER_OBJECT(name, type)                                                                          \
@@ -115,7 +124,7 @@ typedef struct {
     type*                    begin_write_##name(void) {                                                             \
         remote_object_t*        obj = (remote_object_t*)&remote_object_##name;                   \
         triple_buffer_object_t* tb  = (triple_buffer_object_t*)obj->buffer;                      \
-        return (type*)triple_buffer_begin_write_internal(sizeof(type) + LOCAL_OBJECT_EXTRA, tb); \
+        return (type*)transport_slot_object(triple_buffer_begin_write_internal(LOCAL_SLOT_SIZE(sizeof(type)), tb)); \
     }                                                                                                               \
     void end_write_##name(void) {                                                                                   \
         remote_object_t*        obj = (remote_object_t*)&remote_object_##name;                                      \
@@ -128,12 +137,14 @@ typedef struct {
         uint8_t*         start = obj->buffer + LOCAL_OBJECT_SIZE(obj->object_size);                                 \
         start += slave * REMOTE_OBJECT_SIZE(obj->object_size);                                                      \
         triple_buffer_object_t* tb = (triple_buffer_object_t*)start;                                                \
-        return (type*)triple_buffer_read_internal(obj->object_size, tb);                                            \
+        return (type*)transport_slot_object(triple_buffer_read_internal(REMOTE_SLOT_SIZE(obj->object_size), tb));   \
     }
 
 #define REMOTE_OBJECT(name) (remote_object_t*)&remote_object_##name
 
 void add_remote_objects(remote_object_t** remote_objects, uint32_t num_remote_objects);
 void reinitialize_serial_link_transport(void);
-void transport_recv_frame(uint8_t from, uint8_t* data, uint16_t size);
+// Where to receive the frame of an object, starting with its id, or NULL for none
+uint8_t* transport_recv_buffer(uint8_t from, uint8_t* header, uint16_t* capacity);
+void     transport_recv_frame(uint8_t from, uint8_t* data, uint16_t size);
 void update_transport(void);
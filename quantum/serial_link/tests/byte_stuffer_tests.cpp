@@ -58,6 +58,8 @@ ByteStuffer* ByteStuffer::Instance = nullptr;
 extern "C" {
 void validator_recv_frame(uint8_t link, uint8_t* data, uint16_t size) { ByteStuffer::Instance->validator_recv_frame(link, data, size); }
 
+uint8_t* validator_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity) { return NULL; }
+
 void send_data(uint8_t link, const uint8_t* data, uint16_t size) { ByteStuffer::Instance->send_data(link, data, size); }
 }
 
@@ -0,0 +1,246 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+
+using testing::ElementsAre;
+
+extern "C" {
+#include "serial_link/protocol/duplex_link.h"
+#include "serial_link/protocol/byte_stuffer.h"
+#include "serial_link/protocol/physical.h"
+}
+
+#define INITIATOR_LINK 0
+#define TARGET_LINK 1
+
+class DuplexLink : public testing::Test {
+   public:
+    DuplexLink() {
+        Instance = this;
+        init_byte_stuffer();
+        duplex_link_init(&initiator, INITIATOR_LINK, initiator_table, 2);
+        duplex_link_init(&target, TARGET_LINK, target_table, 2);
+    }
+
+    ~DuplexLink() { Instance = nullptr; }
+
+    // Delivers everything on the wire of a side to the other side
+    void deliver(uint8_t link) {
+        std::vector<uint8_t> bytes;
+        bytes.swap(wire[link]);
+        for (uint8_t byte : bytes) {
+            byte_stuffer_recv_byte(link == INITIATOR_LINK ? TARGET_LINK : INITIATOR_LINK, byte);
+        }
+    }
+
+    void deliver_all(void) {
+        while (!wire[INITIATOR_LINK].empty() || !wire[TARGET_LINK].empty()) {
+            deliver(INITIATOR_LINK);
+            deliver(TARGET_LINK);
+        }
+    }
+
+    static DuplexLink* Instance;
+
+    std::vector<uint8_t> wire[2];
+    duplex_link_t        initiator;
+    duplex_link_t        target;
+
+    uint8_t initiator_status[2] = {0, 0};
+    uint8_t initiator_keys[4]   = {1, 2, 3, 4};
+    uint8_t initiator_matrix[3] = {0, 0, 0};
+    uint8_t target_status[2]    = {0, 0};
+    uint8_t target_keys[4]      = {0, 0, 0, 0};
+    uint8_t target_matrix[3]    = {7, 8, 9};
+
+    // a transaction carrying data both ways, and one only from the target
+    SSTD_t initiator_table[2] = {
+        {&initiator_status[0], sizeof(initiator_keys), initiator_keys, sizeof(initiator_matrix), initiator_matrix},
+        {&initiator_status[1], 0, nullptr, sizeof(initiator_matrix), initiator_matrix},
+    };
+    SSTD_t target_table[2] = {
+        {&target_status[0], sizeof(target_keys), target_keys, sizeof(target_matrix), target_matrix},
+        {&target_status[1], 0, nullptr, sizeof(target_matrix), target_matrix},
+    };
+};
+
+DuplexLink* DuplexLink::Instance = nullptr;
+
+extern "C" {
+void send_data(uint8_t link, const uint8_t* data, uint16_t size) { DuplexLink::Instance->wire[link].insert(DuplexLink::Instance->wire[link].end(), data, data + size); }
+
+uint8_t* route_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity) { return NULL; }
+
+void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) { duplex_link_recv_frame(link == INITIATOR_LINK ? &DuplexLink::Instance->initiator : &DuplexLink::Instance->target, data, size); }
+}
+
+TEST_F(DuplexLink, request_is_answered) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    EXPECT_FALSE(duplex_link_answered(&initiator));
+
+    deliver(INITIATOR_LINK);
+    EXPECT_THAT(target_keys, ElementsAre(1, 2, 3, 4));
+    EXPECT_EQ(target_status[0], TRANSACTION_ACCEPTED);
+    EXPECT_FALSE(duplex_link_answered(&initiator));
+
+    deliver(TARGET_LINK);
+    EXPECT_TRUE(duplex_link_answered(&initiator));
+    EXPECT_THAT(initiator_matrix, ElementsAre(7, 8, 9));
+
+    EXPECT_EQ(initiator.stats.frames_sent, 1u);
+    EXPECT_EQ(initiator.stats.frames_received, 1u);
+    EXPECT_EQ(target.stats.frames_sent, 1u);
+    EXPECT_EQ(target.stats.frames_received, 1u);
+    EXPECT_EQ(initiator.stats.errors, 0u);
+}
+
+TEST_F(DuplexLink, request_without_initiator_data_is_answered) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 1, false));
+    deliver_all();
+    EXPECT_TRUE(duplex_link_answered(&initiator));
+    EXPECT_THAT(initiator_matrix, ElementsAre(7, 8, 9));
+    EXPECT_EQ(target_status[1], TRANSACTION_ACCEPTED);
+}
+
+TEST_F(DuplexLink, invalid_transaction_is_not_requested) {
+    EXPECT_FALSE(duplex_link_request(&initiator, 2, false));
+    EXPECT_TRUE(wire[INITIATOR_LINK].empty());
+}
+
+TEST_F(DuplexLink, corrupted_request_is_sent_again) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    wire[INITIATOR_LINK][3] ^= 0x55;
+    deliver_all();
+    EXPECT_FALSE(duplex_link_answered(&initiator));
+    EXPECT_EQ(target_status[0], 0);
+
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, true));
+    deliver_all();
+    EXPECT_TRUE(duplex_link_answered(&initiator));
+    EXPECT_THAT(target_keys, ElementsAre(1, 2, 3, 4));
+    EXPECT_EQ(initiator.stats.retries, 1u);
+    EXPECT_EQ(initiator.stats.errors, 0u);
+}
+
+TEST_F(DuplexLink, corrupted_answer_is_sent_again) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    deliver(INITIATOR_LINK);
+    wire[TARGET_LINK][wire[TARGET_LINK].size() - 2] ^= 0x55;
+    deliver(TARGET_LINK);
+    EXPECT_FALSE(duplex_link_answered(&initiator));
+    EXPECT_THAT(initiator_matrix, ElementsAre(0, 0, 0));
+
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, true));
+    deliver_all();
+    EXPECT_TRUE(duplex_link_answered(&initiator));
+    EXPECT_THAT(initiator_matrix, ElementsAre(7, 8, 9));
+    EXPECT_EQ(target.stats.frames_received, 2u);
+}
+
+TEST_F(DuplexLink, late_answer_to_the_first_try_completes_the_request) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    deliver(INITIATOR_LINK);
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, true));
+    deliver(TARGET_LINK);
+    EXPECT_TRUE(duplex_link_answered(&initiator));
+}
+
+TEST_F(DuplexLink, answer_to_an_older_request_does_not_complete_a_new_one) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    deliver(INITIATOR_LINK);
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    deliver(TARGET_LINK);
+    EXPECT_FALSE(duplex_link_answered(&initiator));
+    // but it still brings the data
+    EXPECT_THAT(initiator_matrix, ElementsAre(7, 8, 9));
+
+    deliver_all();
+    EXPECT_TRUE(duplex_link_answered(&initiator));
+}
+
+TEST_F(DuplexLink, failed_request_counts_as_error) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    wire[INITIATOR_LINK].clear();
+    duplex_link_fail(&initiator);
+    EXPECT_EQ(initiator.stats.errors, 1u);
+
+    // nothing is pending anymore
+    duplex_link_fail(&initiator);
+    EXPECT_EQ(initiator.stats.errors, 1u);
+}
+
+TEST_F(DuplexLink, target_pushes_changes) {
+    duplex_link_push(&target);
+    deliver_all();
+    EXPECT_THAT(initiator_matrix, ElementsAre(7, 8, 9));
+    EXPECT_EQ(target.stats.frames_sent, 2u);
+
+    // nothing changed
+    duplex_link_push(&target);
+    EXPECT_TRUE(wire[TARGET_LINK].empty());
+
+    target_matrix[1] = 42;
+    duplex_link_push(&target);
+    deliver_all();
+    EXPECT_THAT(initiator_matrix, ElementsAre(7, 42, 9));
+    EXPECT_FALSE(duplex_link_answered(&initiator));
+    EXPECT_EQ(initiator.stats.errors, 0u);
+}
+
+TEST_F(DuplexLink, answered_data_is_not_pushed_again) {
+    EXPECT_TRUE(duplex_link_request(&initiator, 0, false));
+    deliver_all();
+    uint32_t sent = target.stats.frames_sent;
+
+    duplex_link_push(&target);
+    // only the other transaction, which wasn't answered yet
+    EXPECT_EQ(target.stats.frames_sent, sent + 1);
+}
+
+TEST_F(DuplexLink, frames_of_the_wrong_size_are_errors) {
+    uint8_t frame[] = {DUPLEX_LINK_PUSH | 0, 0, 7, 8};
+    duplex_link_recv_frame(&initiator, frame, sizeof(frame));
+    EXPECT_EQ(initiator.stats.errors, 1u);
+    EXPECT_EQ(initiator.stats.frames_received, 0u);
+    EXPECT_THAT(initiator_matrix, ElementsAre(0, 0, 0));
+
+    uint8_t unknown[] = {DUPLEX_LINK_PUSH | 5, 0, 7, 8, 9};
+    duplex_link_recv_frame(&initiator, unknown, sizeof(unknown));
+    uint8_t kind[] = {DUPLEX_LINK_KIND_MASK | 0, 0, 7, 8, 9};
+    duplex_link_recv_frame(&initiator, kind, sizeof(kind));
+    duplex_link_recv_frame(&initiator, frame, 1);
+    EXPECT_EQ(initiator.stats.errors, 4u);
+}
+
+TEST_F(DuplexLink, streams_both_ways) {
+    for (int i = 0; i < 1000; i++) {
+        initiator_keys[0] = i;
+        target_matrix[2]  = i * 3;
+        duplex_link_push(&target);
+        EXPECT_TRUE(duplex_link_request(&initiator, i % 2, false));
+        deliver_all();
+        ASSERT_TRUE(duplex_link_answered(&initiator));
+        EXPECT_EQ(initiator_matrix[2], (uint8_t)(i * 3));
+        if (i % 2 == 0) {
+            EXPECT_EQ(target_keys[0], (uint8_t)i);
+        }
+    }
+    EXPECT_EQ(initiator.stats.errors + target.stats.errors, 0u);
+    EXPECT_EQ(initiator.stats.retries, 0u);
+}
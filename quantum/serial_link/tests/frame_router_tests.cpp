@@ -29,6 +29,7 @@ extern "C" {
 #include "serial_link/protocol/transport.h"
 #include "serial_link/protocol/byte_stuffer.h"
 #include "serial_link/protocol/frame_router.h"
+#include "serial_link/protocol/frame_validator.h"
 }
 
 using testing::_;
@@ -37,7 +38,7 @@ using testing::ElementsAreArray;
 
 class FrameRouter : public testing::Test {
    public:
-    FrameRouter() : current_router_buffer(nullptr) {
+    FrameRouter() : current_router_buffer(nullptr), transport_buffer(nullptr) {
         Instance = this;
         init_byte_stuffer();
     }
@@ -72,6 +73,13 @@ class FrameRouter : public testing::Test {
 
     MOCK_METHOD3(transport_recv_frame, void(uint8_t from, uint8_t* data, uint16_t size));
 
+    uint8_t* transport_recv_buffer(uint8_t from, uint8_t* header, uint16_t* capacity) {
+        if (transport_buffer) {
+            *capacity = transport_buffer_size;
+        }
+        return transport_buffer;
+    }
+
     std::vector<uint8_t> received_data;
 
     struct router_buffer {
@@ -81,12 +89,16 @@ class FrameRouter : public testing::Test {
     router_buffer  router_buffers[8];
     router_buffer* current_router_buffer;
 
+    uint8_t* transport_buffer;
+    uint16_t transport_buffer_size;
+
     static FrameRouter* Instance;
 };
 
 FrameRouter* FrameRouter::Instance = nullptr;
 
 typedef struct {
+    uint8_t                header;
     std::array<uint8_t, 4> data;
     uint8_t                extra[16];
 } frame_buffer_t;
@@ -95,13 +107,15 @@ extern "C" {
 void send_data(uint8_t link, const uint8_t* data, uint16_t size) { FrameRouter::Instance->send_data(link, data, size); }
 
 void transport_recv_frame(uint8_t from, uint8_t* data, uint16_t size) { FrameRouter::Instance->transport_recv_frame(from, data, size); }
+
+uint8_t* transport_recv_buffer(uint8_t from, uint8_t* header, uint16_t* capacity) { return FrameRouter::Instance->transport_recv_buffer(from, header, capacity); }
 }
 
 TEST_F(FrameRouter, master_broadcast_is_received_by_everyone) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(0);
-    router_send_frame(0xFF, (uint8_t*)&data, 4);
+    router_send_frame(0xFF, data.data.data(), 4);
     EXPECT_GT(router_buffers[0].send_buffers[DOWN_LINK].size(), 0);
     EXPECT_EQ(router_buffers[0].send_buffers[UP_LINK].size(), 0);
     EXPECT_CALL(*this, transport_recv_frame(0, _, _)).With(Args<1, 2>(ElementsAreArray(data.data)));
@@ -119,7 +133,7 @@ TEST_F(FrameRouter, master_send_is_received_by_targets) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(0);
-    router_send_frame((1 << 1) | (1 << 2), (uint8_t*)&data, 4);
+    router_send_frame((1 << 1) | (1 << 2), data.data.data(), 4);
     EXPECT_GT(router_buffers[0].send_buffers[DOWN_LINK].size(), 0);
     EXPECT_EQ(router_buffers[0].send_buffers[UP_LINK].size(), 0);
 
@@ -142,7 +156,7 @@ TEST_F(FrameRouter, first_link_sends_to_master) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(1);
-    router_send_frame(0, (uint8_t*)&data, 4);
+    router_send_frame(0, data.data.data(), 4);
     EXPECT_GT(router_buffers[1].send_buffers[UP_LINK].size(), 0);
     EXPECT_EQ(router_buffers[1].send_buffers[DOWN_LINK].size(), 0);
 
@@ -156,7 +170,7 @@ TEST_F(FrameRouter, second_link_sends_to_master) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(2);
-    router_send_frame(0, (uint8_t*)&data, 4);
+    router_send_frame(0, data.data.data(), 4);
     EXPECT_GT(router_buffers[2].send_buffers[UP_LINK].size(), 0);
     EXPECT_EQ(router_buffers[2].send_buffers[DOWN_LINK].size(), 0);
 
@@ -174,7 +188,7 @@ TEST_F(FrameRouter, master_sends_to_master_does_nothing) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(0);
-    router_send_frame(0, (uint8_t*)&data, 4);
+    router_send_frame(0, data.data.data(), 4);
     EXPECT_EQ(router_buffers[0].send_buffers[UP_LINK].size(), 0);
     EXPECT_EQ(router_buffers[0].send_buffers[DOWN_LINK].size(), 0);
 }
@@ -183,7 +197,7 @@ TEST_F(FrameRouter, link_sends_to_other_link_does_nothing) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(1);
-    router_send_frame(2, (uint8_t*)&data, 4);
+    router_send_frame(2, data.data.data(), 4);
     EXPECT_EQ(router_buffers[1].send_buffers[UP_LINK].size(), 0);
     EXPECT_EQ(router_buffers[1].send_buffers[DOWN_LINK].size(), 0);
 }
@@ -192,7 +206,7 @@ TEST_F(FrameRouter, master_receives_on_uplink_does_nothing) {
     frame_buffer_t data;
     data.data = {0xAB, 0x70, 0x55, 0xBB};
     activate_router(1);
-    router_send_frame(0, (uint8_t*)&data, 4);
+    router_send_frame(0, data.data.data(), 4);
     EXPECT_GT(router_buffers[1].send_buffers[UP_LINK].size(), 0);
     EXPECT_EQ(router_buffers[1].send_buffers[DOWN_LINK].size(), 0);
 
@@ -202,3 +216,47 @@ TEST_F(FrameRouter, master_receives_on_uplink_does_nothing) {
     EXPECT_EQ(router_buffers[0].send_buffers[UP_LINK].size(), 0);
     EXPECT_EQ(router_buffers[0].send_buffers[DOWN_LINK].size(), 0);
 }
+
+TEST_F(FrameRouter, master_receives_frame_in_place) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_router(1);
+    router_send_frame(0, data.data.data(), 4);
+
+    uint8_t buffer[1 + 4 + VALIDATOR_CRC_SIZE];
+    transport_buffer      = buffer;
+    transport_buffer_size = sizeof(buffer);
+    EXPECT_CALL(*this, transport_recv_frame(1, buffer, 4)).With(Args<1, 2>(ElementsAreArray(data.data)));
+    simulate_transport(1, 0);
+}
+
+TEST_F(FrameRouter, slave_receives_frame_in_place_and_passes_it_on) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_router(0);
+    router_send_frame(0xFF, data.data.data(), 4);
+
+    uint8_t buffer[1 + 4 + VALIDATOR_CRC_SIZE];
+    transport_buffer      = buffer;
+    transport_buffer_size = sizeof(buffer);
+    EXPECT_CALL(*this, transport_recv_frame(0, buffer, 4)).With(Args<1, 2>(ElementsAreArray(data.data)));
+    simulate_transport(0, 1);
+    EXPECT_GT(router_buffers[1].send_buffers[DOWN_LINK].size(), 0);
+
+    transport_buffer = nullptr;
+    EXPECT_CALL(*this, transport_recv_frame(0, _, _)).With(Args<1, 2>(ElementsAreArray(data.data)));
+    simulate_transport(1, 2);
+}
+
+TEST_F(FrameRouter, frame_too_big_for_the_transport_is_dropped) {
+    frame_buffer_t data;
+    data.data = {0xAB, 0x70, 0x55, 0xBB};
+    activate_router(1);
+    router_send_frame(0, data.data.data(), 4);
+
+    uint8_t buffer[1 + 2 + VALIDATOR_CRC_SIZE];
+    transport_buffer      = buffer;
+    transport_buffer_size = sizeof(buffer);
+    EXPECT_CALL(*this, transport_recv_frame(_, _, _)).Times(0);
+    simulate_transport(1, 0);
+}
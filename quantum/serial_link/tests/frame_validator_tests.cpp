@@ -24,8 +24,12 @@ SOFTWARE.
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
 extern "C" {
 #include "serial_link/protocol/frame_validator.h"
+#include "serial_link/protocol/crc.h"
 }
 
 using testing::_;
@@ -49,6 +53,8 @@ FrameValidator* FrameValidator::Instance = nullptr;
 extern "C" {
 void route_incoming_frame(uint8_t link, uint8_t* data, uint16_t size) { FrameValidator::Instance->route_incoming_frame(link, data, size); }
 
+uint8_t* route_recv_buffer(uint8_t link, uint8_t* header, uint16_t* capacity) { return NULL; }
+
 void byte_stuffer_send_frame(uint8_t link, uint8_t* data, uint16_t size) { FrameValidator::Instance->byte_stuffer_send_frame(link, data, size); }
 }
 
@@ -98,3 +104,61 @@ TEST_F(FrameValidator, sends_five_bytes_with_correct_crc) {
     EXPECT_CALL(*this, byte_stuffer_send_frame(_, _, _)).With(Args<1, 2>(ElementsAreArray(expected)));
     validator_send_frame(0, original, 5);
 }
+
+TEST_F(FrameValidator, crc_check_values) {
+    const uint8_t data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(crc32_byte(data, sizeof(data)), 0xCBF43926u);
+    EXPECT_EQ(crc32_slicing_by_4(data, sizeof(data)), 0xCBF43926u);
+    EXPECT_EQ(crc32_slicing_by_8(data, sizeof(data)), 0xCBF43926u);
+    EXPECT_EQ(crc16_ccitt(data, sizeof(data)), 0x906E);
+}
+
+TEST_F(FrameValidator, crc_backends_agree) {
+    uint8_t data[512 + 8];
+    srand(1);
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = rand();
+    }
+
+    // every length around the 4 and 8 byte steps, from every alignment
+    for (uint8_t offset = 0; offset < 8; offset++) {
+        for (uint16_t size = 0; size <= 512; size++) {
+            uint32_t expected = crc32_byte(data + offset, size);
+            ASSERT_EQ(crc32_slicing_by_4(data + offset, size), expected) << "size " << size << " offset " << (int)offset;
+            ASSERT_EQ(crc32_slicing_by_8(data + offset, size), expected) << "size " << size << " offset " << (int)offset;
+        }
+    }
+}
+
+TEST_F(FrameValidator, crc_throughput) {
+    static uint8_t data[1024];
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = i * 7;
+    }
+
+    struct {
+        const char* name;
+        uint32_t (*crc)(const uint8_t*, uint16_t);
+    } backends[] = {
+        {"crc32_byte", crc32_byte},
+        {"crc32_slicing_by_4", crc32_slicing_by_4},
+        {"crc32_slicing_by_8", crc32_slicing_by_8},
+        {"crc16_ccitt", [](const uint8_t* data, uint16_t size) -> uint32_t { return crc16_ccitt(data, size); }},
+    };
+
+    for (auto& backend : backends) {
+        const int         rounds = 4096;
+        volatile uint32_t crc;
+        auto              start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++) {
+            data[0] = i;
+            crc     = backend.crc(data, sizeof(data));
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        (void)crc;
+
+        double mb_per_s = rounds * sizeof(data) / elapsed.count() / 1e6;
+        std::cout << backend.name << ": " << mb_per_s << " MB/s" << std::endl;
+        RecordProperty(backend.name, (int)mb_per_s);
+    }
+}
@@ -4,12 +4,14 @@ serial_link_byte_stuffer_SRC :=\
 
 serial_link_frame_validator_SRC := \
 	$(SERIAL_PATH)/tests/frame_validator_tests.cpp \
-	$(SERIAL_PATH)/protocol/frame_validator.c 
+	$(SERIAL_PATH)/protocol/frame_validator.c \
+	$(SERIAL_PATH)/protocol/crc.c
 
 serial_link_frame_router_SRC := \
 	$(SERIAL_PATH)/tests/frame_router_tests.cpp \
 	$(SERIAL_PATH)/protocol/byte_stuffer.c \
 	$(SERIAL_PATH)/protocol/frame_validator.c \
+	$(SERIAL_PATH)/protocol/crc.c \
 	$(SERIAL_PATH)/protocol/frame_router.c
 
 serial_link_triple_buffered_object_SRC := \
@@ -20,3 +22,11 @@ serial_link_transport_SRC := \
 	$(SERIAL_PATH)/tests/transport_tests.cpp \
 	$(SERIAL_PATH)/protocol/transport.c \
 	$(SERIAL_PATH)/protocol/triple_buffered_object.c 
+
+serial_link_duplex_link_INC := $(DRIVER_PATH)/chibios
+serial_link_duplex_link_SRC := \
+	$(SERIAL_PATH)/tests/duplex_link_tests.cpp \
+	$(SERIAL_PATH)/protocol/duplex_link.c \
+	$(SERIAL_PATH)/protocol/byte_stuffer.c \
+	$(SERIAL_PATH)/protocol/frame_validator.c \
+	$(SERIAL_PATH)/protocol/crc.c
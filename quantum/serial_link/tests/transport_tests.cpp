@@ -148,7 +148,7 @@ TEST_F(Transport, ignores_object_with_invalid_id) {
     end_write_master_to_single_slave(3);
     EXPECT_CALL(*this, router_send_frame(4));
     update_transport();
-    sent_data[sent_data.size() - 1] = 44;
+    sent_data[0] = 44;
     transport_recv_frame(0, sent_data.data(), sent_data.size());
     test_object1* obj2 = read_master_to_single_slave();
     EXPECT_EQ(obj2, nullptr);
@@ -182,3 +182,58 @@ TEST_F(Transport, ignores_object_with_size_too_big) {
     test_object1* obj2 = read_master_to_slave();
     EXPECT_EQ(obj2, nullptr);
 }
+
+TEST_F(Transport, sends_the_object_id_first) {
+    update_transport();
+    test_object1* obj = begin_write_slave_to_master();
+    obj->test         = 7;
+    EXPECT_CALL(*this, signal_data_written());
+    end_write_slave_to_master();
+    EXPECT_CALL(*this, router_send_frame(0));
+    update_transport();
+    EXPECT_EQ(sent_data.size(), 5);
+    EXPECT_EQ(sent_data[0], 2);
+}
+
+TEST_F(Transport, receives_frames_in_place) {
+    uint8_t  header   = 0;
+    uint16_t capacity = 0;
+    uint8_t* buffer   = transport_recv_buffer(0, &header, &capacity);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_GE(capacity, 1 + sizeof(test_object1) + 4);
+    EXPECT_EQ((uintptr_t)(buffer + 1) % 4, 0);
+    buffer[0]           = header;
+    test_object1 object = {5};
+    memcpy(buffer + 1, &object, sizeof(object));
+    transport_recv_frame(0, buffer, 1 + sizeof(object));
+    test_object1* obj2 = read_master_to_slave();
+    EXPECT_EQ((uint8_t*)obj2, buffer + 1);
+    EXPECT_EQ(obj2->test, 5);
+}
+
+TEST_F(Transport, receives_frames_in_place_from_each_slave) {
+    uint8_t  header   = 2;
+    uint16_t capacity = 0;
+    uint8_t* buffer1  = transport_recv_buffer(1, &header, &capacity);
+    uint8_t* buffer2  = transport_recv_buffer(2, &header, &capacity);
+    ASSERT_NE(buffer1, nullptr);
+    ASSERT_NE(buffer2, nullptr);
+    EXPECT_NE(buffer1, buffer2);
+    buffer2[0]          = header;
+    test_object1 object = {7};
+    memcpy(buffer2 + 1, &object, sizeof(object));
+    transport_recv_frame(2, buffer2, 1 + sizeof(object));
+    EXPECT_EQ(read_slave_to_master(0), nullptr);
+    test_object1* obj2 = read_slave_to_master(1);
+    EXPECT_EQ((uint8_t*)obj2, buffer2 + 1);
+    EXPECT_EQ(obj2->test, 7);
+}
+
+TEST_F(Transport, has_no_receive_buffer_for_invalid_frames) {
+    uint16_t capacity = 0;
+    uint8_t  header   = 44;
+    EXPECT_EQ(transport_recv_buffer(0, &header, &capacity), nullptr);
+    header = 2;
+    EXPECT_EQ(transport_recv_buffer(0, &header, &capacity), nullptr);
+    EXPECT_EQ(transport_recv_buffer(NUM_SLAVES + 1, &header, &capacity), nullptr);
+}
@@ -293,6 +293,13 @@ bool matrix_post_scan(void) {
 uint8_t matrix_scan(void) {
     bool local_changed = false;
 
+#ifdef SPLIT_TRANSPORT_PIPELINE
+    // exchange with the slave while scanning this half, matrix_post_scan() then waits for it
+    if (is_keyboard_master()) {
+        transport_master_start();
+    }
+#endif
+
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -18,8 +18,6 @@
 
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
-static pin_t encoders_pad[] = ENCODERS_PAD_A;
-#    define NUMBER_OF_ENCODERS (sizeof(encoders_pad) / sizeof(pin_t))
 #endif
 
 #if defined(USE_I2C)
@@ -49,7 +47,8 @@ typedef struct _I2C_slave_buffer_t {
     rgblight_syncinfo_t rgblight_sync;
 #    endif
 #    ifdef ENCODER_ENABLE
-    uint8_t encoder_state[NUMBER_OF_ENCODERS];
+    encoder_log_t encoder_state;
+    uint8_t       encoder_ack;
 #    endif
 #    ifdef WPM_ENABLE
     uint8_t current_wpm;
@@ -67,6 +66,7 @@ static I2C_slave_buffer_t *const i2c_buffer = (I2C_slave_buffer_t *)i2c_slave_re
 #    define I2C_BACKLIGHT_START offsetof(I2C_slave_buffer_t, backlight_level)
 #    define I2C_RGB_START offsetof(I2C_slave_buffer_t, rgblight_sync)
 #    define I2C_ENCODER_START offsetof(I2C_slave_buffer_t, encoder_state)
+#    define I2C_ENCODER_ACK_START offsetof(I2C_slave_buffer_t, encoder_ack)
 #    define I2C_WPM_START offsetof(I2C_slave_buffer_t, current_wpm)
 
 #    define TIMEOUT 100
@@ -75,6 +75,11 @@ static I2C_slave_buffer_t *const i2c_buffer = (I2C_slave_buffer_t *)i2c_slave_re
 #        define SLAVE_I2C_ADDRESS 0x32
 #    endif
 
+#    ifdef SPLIT_TRANSPORT_PIPELINE
+// The I2C transfers block, and all run in transport_master()
+void transport_master_start(void) {}
+#    endif
+
 // Get rows from other half over i2c
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     i2c_readReg(SLAVE_I2C_ADDRESS, I2C_KEYMAP_SLAVE_START, (void *)slave_matrix, sizeof(i2c_buffer->smatrix), TIMEOUT);
@@ -103,8 +108,14 @@ bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    i2c_readReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_START, (void *)i2c_buffer->encoder_state, sizeof(i2c_buffer->encoder_state), TIMEOUT);
-    encoder_update_raw(i2c_buffer->encoder_state);
+    if (i2c_readReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_START, (void *)&i2c_buffer->encoder_state, sizeof(i2c_buffer->encoder_state), TIMEOUT) >= 0) {
+        uint8_t encoder_ack = encoder_update_raw(&i2c_buffer->encoder_state);
+        if (encoder_ack != i2c_buffer->encoder_ack) {
+            if (i2c_writeReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_ACK_START, (void *)&encoder_ack, sizeof(encoder_ack), TIMEOUT) >= 0) {
+                i2c_buffer->encoder_ack = encoder_ack;
+            }
+        }
+    }
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -172,7 +183,7 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    encoder_state_raw(i2c_buffer->encoder_state);
+    encoder_state_raw(&i2c_buffer->encoder_state, i2c_buffer->encoder_ack);
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -201,7 +212,7 @@ typedef struct _Serial_s2m_buffer_t {
     matrix_row_t smatrix[ROWS_PER_HAND];
 
 #    ifdef ENCODER_ENABLE
-    uint8_t      encoder_state[NUMBER_OF_ENCODERS];
+    encoder_log_t encoder_state;
 #    endif
 
 } Serial_s2m_buffer_t;
@@ -226,6 +237,9 @@ typedef struct _Serial_m2s_buffer_t {
 #    ifdef WPM_ENABLE
     uint8_t      current_wpm;
 #    endif
+#    ifdef ENCODER_ENABLE
+    uint8_t      encoder_ack;
+#    endif
 } Serial_m2s_buffer_t;
 
 #    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
@@ -302,17 +316,48 @@ void transport_rgblight_slave(void) {
 #        define transport_rgblight_slave()
 #    endif
 
-bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-#    ifndef SERIAL_USE_MULTI_TRANSACTION
-    if (soft_serial_transaction() != TRANSACTION_END) {
-        return false;
-    }
+#    if defined(SPLIT_TRANSPORT_PIPELINE) && (defined(SERIAL_DRIVER_USART) || defined(SERIAL_DRIVER_USART_DUPLEX))
+
+#        ifdef SERIAL_DRIVER_USART
+// The half duplex driver only runs a transaction in the background when all of it fits in its input queue:
+// the transaction id and the data sent, which it reads back, plus the answer and its handshake byte
+_Static_assert(1 + sizeof(serial_m2s_buffer) + 1 + sizeof(serial_s2m_buffer) <= SERIAL_BUFFERS_SIZE, "SPLIT_TRANSPORT_PIPELINE needs a larger SERIAL_BUFFERS_SIZE in halconf.h");
+#        endif
+
+// The usart drivers exchange the matrices in the background, while the master scans its own
+void transport_master_start(void) {
+#        ifndef SERIAL_USE_MULTI_TRANSACTION
+    soft_serial_transaction_start();
+#        else
+    transport_rgblight_master();
+    soft_serial_transaction_start(GET_SLAVE_MATRIX);
+#        endif
+}
+
+static int transport_master_transaction(void) { return soft_serial_transaction_wait(); }
+
 #    else
+
+#        ifdef SPLIT_TRANSPORT_PIPELINE
+// The other serial drivers block, and the exchange runs in transport_master()
+void transport_master_start(void) {}
+#        endif
+
+static int transport_master_transaction(void) {
+#        ifndef SERIAL_USE_MULTI_TRANSACTION
+    return soft_serial_transaction();
+#        else
     transport_rgblight_master();
-    if (soft_serial_transaction(GET_SLAVE_MATRIX) != TRANSACTION_END) {
+    return soft_serial_transaction(GET_SLAVE_MATRIX);
+#        endif
+}
+
+#    endif
+
+bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (transport_master_transaction() != TRANSACTION_END) {
         return false;
     }
-#    endif
 
     // TODO:  if MATRIX_COLS > 8 change to unpack()
     for (int i = 0; i < ROWS_PER_HAND; ++i) {
@@ -328,7 +373,7 @@ bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    encoder_update_raw((uint8_t *)serial_s2m_buffer.encoder_state);
+    serial_m2s_buffer.encoder_ack = encoder_update_raw((encoder_log_t *)&serial_s2m_buffer.encoder_state);
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -367,7 +412,7 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    encoder_state_raw((uint8_t *)serial_s2m_buffer.encoder_state);
+    encoder_state_raw((encoder_log_t *)&serial_s2m_buffer.encoder_state, serial_m2s_buffer.encoder_ack);
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -5,6 +5,11 @@
 void transport_master_init(void);
 void transport_slave_init(void);
 
+#ifdef SPLIT_TRANSPORT_PIPELINE
+// starts the exchange with the slave, which runs while the master scans its own matrix
+void transport_master_start(void);
+#endif
+
 // returns false if valid data not received from slave
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
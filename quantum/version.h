@@ -0,0 +1,4 @@
+#define QMK_VERSION "774815"
+#define QMK_BUILDDATE "2026-10-19-04:09:40"
+#define CHIBIOS_VERSION "774815"
+#define CHIBIOS_CONTRIB_VERSION "774815"
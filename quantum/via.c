@@ -47,6 +47,7 @@
 #include "tmk_core/common/eeprom.h"
 #include "version.h"  // for QMK_BUILDDATE used in EEPROM magic
 #include "via_ensure_keycode.h"
+#include <string.h>
 
 // Forward declare some helpers.
 #if defined(VIA_QMK_BACKLIGHT_ENABLE)
@@ -59,6 +60,12 @@ void via_qmk_rgblight_set_value(uint8_t *data);
 void via_qmk_rgblight_get_value(uint8_t *data);
 #endif
 
+#if defined(MOUSEKEY_ENABLE) && defined(MK_PHYSICS)
+#    include "mousekey.h"
+bool via_mousekey_curve_set_value(uint8_t *data);
+bool via_mousekey_curve_get_value(uint8_t *data);
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -185,6 +192,189 @@ bool process_record_via(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
+#if defined(VIA_BULK_TRANSFER_ENABLE)
+
+#    ifndef VIA_BULK_WINDOW_PACKETS
+#        define VIA_BULK_WINDOW_PACKETS 16
+#    endif
+
+enum via_bulk_packet_offset {
+    bulk_region = 1,
+    bulk_offset = 2,
+    bulk_size   = 4,
+    bulk_status = 6,
+    bulk_crc    = 7,
+    bulk_window = 9,
+};
+
+// State of the id_bulk_write in progress
+static struct {
+    uint8_t  region;  // 0 when no write is in progress
+    uint8_t  status;
+    uint8_t  sequence;  // of the next data packet
+    uint16_t offset;
+    uint16_t size;
+    uint16_t received;
+    uint16_t crc;
+} via_bulk_write_state;
+
+static uint16_t via_bulk_crc16(uint16_t crc, const uint8_t *data, uint16_t size) {
+    while (size--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t via_bulk_region_size(uint8_t region) {
+    switch (region) {
+        case id_bulk_keymap:
+            return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_bulk_macros:
+            return dynamic_keymap_macro_get_buffer_size();
+        case id_bulk_custom_config:
+            return VIA_EEPROM_CUSTOM_CONFIG_SIZE;
+        default:
+            return 0;
+    }
+}
+
+static void via_bulk_region_read(uint8_t region, uint16_t offset, uint16_t size, uint8_t *data) {
+    switch (region) {
+        case id_bulk_keymap:
+            dynamic_keymap_get_buffer(offset, size, data);
+            break;
+        case id_bulk_macros:
+            dynamic_keymap_macro_get_buffer(offset, size, data);
+            break;
+        case id_bulk_custom_config:
+            eeprom_read_block(data, (void *)(VIA_EEPROM_CUSTOM_CONFIG_ADDR + offset), size);
+            break;
+    }
+}
+
+static void via_bulk_region_write(uint8_t region, uint16_t offset, uint16_t size, uint8_t *data) {
+    switch (region) {
+        case id_bulk_keymap:
+            dynamic_keymap_set_buffer(offset, size, data);
+            break;
+        case id_bulk_macros:
+            dynamic_keymap_macro_set_buffer(offset, size, data);
+            break;
+        case id_bulk_custom_config:
+            eeprom_update_block(data, (void *)(VIA_EEPROM_CUSTOM_CONFIG_ADDR + offset), size);
+            break;
+    }
+}
+
+// Checks the region, offset and size of a request, and fills in the window size of the acknowledgement
+static bool via_bulk_check_request(uint8_t *data, uint8_t length) {
+    uint16_t window = VIA_BULK_WINDOW_PACKETS * (length - 2);
+    uint16_t offset = (data[bulk_offset] << 8) | data[bulk_offset + 1];
+    uint16_t size   = (data[bulk_size] << 8) | data[bulk_size + 1];
+    uint16_t limit  = via_bulk_region_size(data[bulk_region]);
+
+    data[bulk_status]     = id_bulk_ok;
+    data[bulk_crc]        = 0;
+    data[bulk_crc + 1]    = 0;
+    data[bulk_window]     = window >> 8;
+    data[bulk_window + 1] = window & 0xFF;
+    if (size == 0 || size > window || offset >= limit || size > limit - offset) {
+        data[bulk_status] = id_bulk_invalid_range;
+        return false;
+    }
+    return true;
+}
+
+// Sends the data packets of a read, leaving the acknowledgement in data
+static void via_bulk_read(uint8_t *data, uint8_t length) {
+    uint8_t  request[bulk_window + 2];
+    uint16_t crc = 0xFFFF;
+
+    if (via_bulk_check_request(data, length)) {
+        memcpy(request, data, sizeof(request));
+        uint8_t  region   = request[bulk_region];
+        uint16_t offset   = (request[bulk_offset] << 8) | request[bulk_offset + 1];
+        uint16_t size     = (request[bulk_size] << 8) | request[bulk_size + 1];
+        uint8_t  sequence = 0;
+        while (size > 0) {
+            uint8_t chunk = length - 2;
+            if (chunk > size) {
+                chunk = size;
+            }
+            memset(data, 0, length);
+            data[0] = id_bulk_data;
+            data[1] = sequence++;
+            via_bulk_region_read(region, offset, chunk, &data[2]);
+            crc = via_bulk_crc16(crc, &data[2], chunk);
+            raw_hid_send(data, length);
+            offset += chunk;
+            size -= chunk;
+        }
+        memset(data, 0, length);
+        memcpy(data, request, sizeof(request));
+        data[bulk_crc]     = crc >> 8;
+        data[bulk_crc + 1] = crc & 0xFF;
+    }
+}
+
+static void via_bulk_write_begin(uint8_t *data, uint8_t length) {
+    via_bulk_write_state.region = 0;
+    if (via_bulk_check_request(data, length)) {
+        via_bulk_write_state.region   = data[bulk_region];
+        via_bulk_write_state.status   = id_bulk_ok;
+        via_bulk_write_state.sequence = 0;
+        via_bulk_write_state.offset   = (data[bulk_offset] << 8) | data[bulk_offset + 1];
+        via_bulk_write_state.size     = (data[bulk_size] << 8) | data[bulk_size + 1];
+        via_bulk_write_state.received = 0;
+        via_bulk_write_state.crc      = 0xFFFF;
+    }
+}
+
+// Returns true when an acknowledgement has been left in data
+static bool via_bulk_write_data(uint8_t *data, uint8_t length) {
+    if (via_bulk_write_state.region == 0) {
+        memset(data, 0, length);
+        data[0]           = id_bulk_write;
+        data[bulk_status] = id_bulk_no_transfer;
+        return true;
+    }
+
+    uint8_t chunk = length - 2;
+    if (chunk > via_bulk_write_state.size - via_bulk_write_state.received) {
+        chunk = via_bulk_write_state.size - via_bulk_write_state.received;
+    }
+    if (data[1] != via_bulk_write_state.sequence++) {
+        // Keep counting packets so the host gets its acknowledgement, but stop writing
+        via_bulk_write_state.status = id_bulk_sequence_error;
+    }
+    if (via_bulk_write_state.status == id_bulk_ok) {
+        via_bulk_region_write(via_bulk_write_state.region, via_bulk_write_state.offset + via_bulk_write_state.received, chunk, &data[2]);
+        via_bulk_write_state.crc = via_bulk_crc16(via_bulk_write_state.crc, &data[2], chunk);
+    }
+    via_bulk_write_state.received += chunk;
+    if (via_bulk_write_state.received < via_bulk_write_state.size) {
+        return false;
+    }
+
+    memset(data, 0, length);
+    data[0]               = id_bulk_write;
+    data[bulk_region]     = via_bulk_write_state.region;
+    data[bulk_offset]     = via_bulk_write_state.offset >> 8;
+    data[bulk_offset + 1] = via_bulk_write_state.offset & 0xFF;
+    data[bulk_size]       = via_bulk_write_state.size >> 8;
+    data[bulk_size + 1]   = via_bulk_write_state.size & 0xFF;
+    data[bulk_status]     = via_bulk_write_state.status;
+    data[bulk_crc]        = via_bulk_write_state.crc >> 8;
+    data[bulk_crc + 1]    = via_bulk_write_state.crc & 0xFF;
+    via_bulk_write_state.region = 0;
+    return true;
+}
+
+#endif
+
 // Keyboard level code can override this to handle custom messages from VIA.
 // See raw_hid_receive() implementation.
 // DO NOT call raw_hid_send() in the override function.
@@ -246,6 +436,14 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 #endif
                     break;
                 }
+#if defined(MOUSEKEY_ENABLE) && defined(MK_PHYSICS)
+                case id_mousekey_curve: {
+                    if (!via_mousekey_curve_get_value(&command_data[1])) {
+                        *command_id = id_unhandled;
+                    }
+                    break;
+                }
+#endif
                 default: {
                     raw_hid_receive_kb(data, length);
                     break;
@@ -260,6 +458,14 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     via_set_layout_options(value);
                     break;
                 }
+#if defined(MOUSEKEY_ENABLE) && defined(MK_PHYSICS)
+                case id_mousekey_curve: {
+                    if (!via_mousekey_curve_set_value(&command_data[1])) {
+                        *command_id = id_unhandled;
+                    }
+                    break;
+                }
+#endif
                 default: {
                     raw_hid_receive_kb(data, length);
                     break;
@@ -371,6 +577,23 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#if defined(VIA_BULK_TRANSFER_ENABLE)
+        case id_bulk_read: {
+            via_bulk_read(data, length);
+            break;
+        }
+        case id_bulk_write: {
+            via_bulk_write_begin(data, length);
+            break;
+        }
+        case id_bulk_data: {
+            if (!via_bulk_write_data(data, length)) {
+                // Only the last packet of the window is acknowledged
+                return;
+            }
+            break;
+        }
+#endif
         default: {
             // The command ID is not known
             // Return the unhandled state
@@ -489,3 +712,44 @@ void via_qmk_rgblight_set_value(uint8_t *data) {
 }
 
 #endif  // #if defined(VIA_QMK_RGBLIGHT_ENABLE)
+
+#if defined(MOUSEKEY_ENABLE) && defined(MK_PHYSICS)
+
+// The curves are not saved, keyboards can keep them with their own settings and set mousekey_curves at startup
+bool via_mousekey_curve_get_value(uint8_t *data) {
+    uint8_t *curve_id   = &(data[0]);
+    uint8_t *value_data = &(data[1]);
+    if (*curve_id >= MOUSEKEY_CURVE_COUNT) {
+        return false;
+    }
+    const mousekey_curve_t *curve    = &mousekey_curves[*curve_id];
+    const uint16_t          values[] = {curve->step, curve->delay, curve->initial_speed, curve->acceleration, curve->max_speed, curve->friction};
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        value_data[i * 2]     = values[i] >> 8;
+        value_data[i * 2 + 1] = values[i] & 0xFF;
+    }
+    return true;
+}
+
+bool via_mousekey_curve_set_value(uint8_t *data) {
+    uint8_t *curve_id   = &(data[0]);
+    uint8_t *value_data = &(data[1]);
+    if (*curve_id >= MOUSEKEY_CURVE_COUNT) {
+        return false;
+    }
+    uint16_t values[6];
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        values[i] = (value_data[i * 2] << 8) | value_data[i * 2 + 1];
+    }
+    mousekey_curves[*curve_id] = (mousekey_curve_t){
+        .step          = values[0],
+        .delay         = values[1],
+        .initial_speed = values[2],
+        .acceleration  = values[3],
+        .max_speed     = values[4],
+        .friction      = values[5],
+    };
+    return true;
+}
+
+#endif  // #if defined(MOUSEKEY_ENABLE) && defined(MK_PHYSICS)
@@ -78,13 +78,42 @@ enum via_command_id {
     id_dynamic_keymap_get_layer_count       = 0x11,
     id_dynamic_keymap_get_buffer            = 0x12,
     id_dynamic_keymap_set_buffer            = 0x13,
+    id_bulk_read                            = 0x14,
+    id_bulk_write                           = 0x15,
+    id_bulk_data                            = 0x16,
     id_unhandled                            = 0xFF,
 };
 
+// Bulk transfers (VIA_BULK_TRANSFER_ENABLE) move a window of up to VIA_BULK_WINDOW_PACKETS
+// packets with a single acknowledgement, instead of one round-trip per 28 bytes.
+//
+// Requests and acknowledgements use the layout
+//   [command_id, region, offset_hi, offset_lo, size_hi, size_lo, status, crc_hi, crc_lo, window_hi, window_lo]
+// where window is the largest size accepted in one request, and crc is CRC-16/CCITT-FALSE
+// over the data transferred. Data packets are [id_bulk_data, sequence, data...], carrying
+// up to the packet size minus 2 bytes.
+//
+// id_bulk_read: the keyboard sends the data packets, then the acknowledgement.
+// id_bulk_write: the keyboard acknowledges the request, then stays silent while the host sends
+// the data packets, and acknowledges again (as id_bulk_write) after the last one.
+enum via_bulk_region {
+    id_bulk_keymap        = 0x01,  // as id_dynamic_keymap_get_buffer
+    id_bulk_macros        = 0x02,  // as id_dynamic_keymap_macro_get_buffer
+    id_bulk_custom_config = 0x03,  // VIA_EEPROM_CUSTOM_CONFIG_SIZE bytes, e.g. keyboard level lighting settings
+};
+
+enum via_bulk_status {
+    id_bulk_ok             = 0x00,
+    id_bulk_invalid_range  = 0x01,  // unknown region, or offset and size outside it or the window
+    id_bulk_sequence_error = 0x02,  // a data packet was lost or repeated, the window must be sent again
+    id_bulk_no_transfer    = 0x03,  // data packet without an id_bulk_write request
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,  //
     id_layout_options      = 0x02,
-    id_switch_matrix_state = 0x03
+    id_switch_matrix_state = 0x03,
+    id_mousekey_curve      = 0x04,  // curve, then step, delay, initial speed, acceleration, max speed and friction, 16 bits each
 };
 
 enum via_lighting_value {
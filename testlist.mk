@@ -2,7 +2,14 @@ TEST_LIST = $(notdir $(patsubst %/rules.mk,%,$(wildcard $(ROOT_DIR)/tests/*/rule
 FULL_TESTS := $(TEST_LIST)
 
 include $(ROOT_DIR)/quantum/sequencer/tests/testlist.mk
+include $(ROOT_DIR)/quantum/leader/tests/testlist.mk
+include $(ROOT_DIR)/quantum/debounce/tests/testlist.mk
+include $(ROOT_DIR)/tmk_core/protocol/arm_atsam/tests/testlist.mk
 include $(ROOT_DIR)/quantum/serial_link/tests/testlist.mk
+include $(ROOT_DIR)/quantum/audio/tests/testlist.mk
+include $(ROOT_DIR)/quantum/encoder/tests/testlist.mk
+include $(ROOT_DIR)/quantum/mousekey/tests/testlist.mk
+include $(ROOT_DIR)/tmk_core/common/tests/testlist.mk
 
 define VALIDATE_TEST_LIST
     ifneq ($1,)
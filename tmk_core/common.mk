@@ -17,6 +17,10 @@ TMK_COMMON_SRC +=	$(COMMON_DIR)/host.c \
 	$(COMMON_DIR)/sync_timer.c \
 	$(PLATFORM_COMMON_DIR)/bootloader.c \
 
+ifeq ($(PLATFORM),CHIBIOS)
+    TMK_COMMON_SRC += $(COMMON_DIR)/suspend_state.c
+endif
+
 # Use platform provided print - fall back to lib/printf
 ifneq ("$(wildcard $(TMK_PATH)/$(PLATFORM_COMMON_DIR)/printf.mk)","")
     include $(TMK_PATH)/$(PLATFORM_COMMON_DIR)/printf.mk
@@ -75,6 +79,11 @@ endif
 
 ifeq ($(strip $(CONSOLE_ENABLE)), yes)
     TMK_COMMON_DEFS += -DCONSOLE_ENABLE
+
+    ifeq ($(strip $(DEFERRED_DEBUG_ENABLE)), yes)
+        TMK_COMMON_DEFS += -DDEFERRED_DEBUG_ENABLE
+        TMK_COMMON_SRC += $(COMMON_DIR)/debug_log.c
+    endif
 else
     TMK_COMMON_DEFS += -DNO_PRINT
     TMK_COMMON_DEFS += -DNO_DEBUG
@@ -124,6 +124,23 @@ inline uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(t, last);
 }
 
+/** \brief timer read us32
+ *
+ * Milliseconds from timer_count, plus the microseconds elapsed in the current one from the timer 0 counter.
+ */
+uint32_t timer_read_us32(void) {
+    uint32_t t;
+    uint8_t  raw;
+
+    // retry if the compare interrupt ran in between the two reads
+    do {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { t = timer_count; }
+        raw = TIMER_RAW;
+    } while (t != timer_read32());
+
+    return t * 1000 + (uint32_t)raw * 1000 / TIMER_RAW_TOP;
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -9,8 +9,10 @@
 #include "mousekey.h"
 #include "host.h"
 #include "suspend.h"
+#include "suspend_state.h"
 #include "led.h"
 #include "wait.h"
+#include "gpio.h"
 
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
@@ -24,6 +26,10 @@
 #    include "rgblight.h"
 #endif
 
+#if defined(SUSPEND_LOW_POWER) && defined(RGB_MATRIX_ENABLE)
+#    include "rgb_matrix.h"
+#endif
+
 /** \brief suspend idle
  *
  * FIXME: needs doc
@@ -44,11 +50,11 @@ __attribute__((weak)) void suspend_power_down_user(void) {}
  */
 __attribute__((weak)) void suspend_power_down_kb(void) { suspend_power_down_user(); }
 
-/** \brief suspend power down
+/** \brief Turn off the peripherals
  *
- * FIXME: needs doc
+ * Runs once per suspend, before the first sleep.
  */
-void suspend_power_down(void) {
+void suspend_sleep_peripherals_off(void) {
 #ifdef BACKLIGHT_ENABLE
     backlight_set(0);
 #endif
@@ -63,23 +69,152 @@ void suspend_power_down(void) {
 #endif
     led_set(leds_off);
 
-    // TODO: figure out what to power down and how
-    // shouldn't power down TPM/FTM if we want a breathing LED
-    // also shouldn't power down USB
 #if defined(RGBLIGHT_SLEEP) && defined(RGBLIGHT_ENABLE)
     rgblight_suspend();
 #endif
+#if defined(SUSPEND_LOW_POWER) && defined(RGB_MATRIX_ENABLE)
+    // the matrix task doesn't run while the MCU sleeps, so blank the LEDs now
+    rgb_matrix_set_color_all(0, 0, 0);
+    rgb_matrix_update_pwm_buffers();
+#endif
 #ifdef AUDIO_ENABLE
     stop_all_notes();
 #endif /* AUDIO_ENABLE */
 
     suspend_power_down_kb();
-    // on AVR, this enables the watchdog for 15ms (max), and goes to
-    // SLEEP_MODE_PWR_DOWN
+}
+
+#ifdef SUSPEND_LOW_POWER
+#    if !defined(STM32F1XX) && !defined(STM32F3XX)
+// Without stop mode, the system tick would wake the core up on every tick
+#        error "SUSPEND_LOW_POWER is only supported on STM32F1xx and STM32F3xx"
+#    endif
+#    if !PAL_USE_CALLBACKS && !PAL_USE_WAIT
+#        error "SUSPEND_LOW_POWER needs PAL_USE_WAIT or PAL_USE_CALLBACKS enabled in halconf.h"
+#    endif
+
+// Keys wake the MCU by pulling a sense pin low, while all the drive pins are driven low
+#    if defined(DIRECT_PINS)
+static const pin_t direct_pins[MATRIX_ROWS][MATRIX_COLS] = DIRECT_PINS;
+#        define SENSE_PIN_COUNT (MATRIX_ROWS * MATRIX_COLS)
+#        define SENSE_PIN(i) (direct_pins[(i) / MATRIX_COLS][(i) % MATRIX_COLS])
+#        define DRIVE_PIN_COUNT 0
+#        define DRIVE_PIN(i) NO_PIN
+#    elif (DIODE_DIRECTION == COL2ROW) || (DIODE_DIRECTION == ROW2COL)
+#        if (DIODE_DIRECTION == COL2ROW)
+static const pin_t drive_pins[] = MATRIX_ROW_PINS;
+static const pin_t sense_pins[] = MATRIX_COL_PINS;
+#        else
+static const pin_t drive_pins[] = MATRIX_COL_PINS;
+static const pin_t sense_pins[] = MATRIX_ROW_PINS;
+#        endif
+#        define SENSE_PIN_COUNT (sizeof(sense_pins) / sizeof(pin_t))
+#        define SENSE_PIN(i) (sense_pins[i])
+#        define DRIVE_PIN_COUNT (sizeof(drive_pins) / sizeof(pin_t))
+#        define DRIVE_PIN(i) (drive_pins[i])
+#    else
+#        error "SUSPEND_LOW_POWER needs DIRECT_PINS, or MATRIX_ROW_PINS and MATRIX_COL_PINS with a DIODE_DIRECTION"
+#    endif
 
-    wait_ms(17);
+/** \brief Let the keys wake up the MCU
+ *
+ * Every sense pin needs its own EXTI line, so two of them can't share a pad
+ * number on different ports. A key that is already pressed would never make
+ * an edge, so the MCU doesn't sleep until it is released.
+ */
+bool suspend_sleep_arm(void) {
+    uint32_t lines = 0;
+    for (uint8_t i = 0; i < SENSE_PIN_COUNT; i++) {
+        if (SENSE_PIN(i) == NO_PIN) continue;
+        uint32_t line = 1UL << PAL_PAD(SENSE_PIN(i));
+        if (lines & line) return false;
+        lines |= line;
+    }
+
+    for (uint8_t i = 0; i < DRIVE_PIN_COUNT; i++) {
+        if (DRIVE_PIN(i) == NO_PIN) continue;
+        setPinOutput(DRIVE_PIN(i));
+        writePinLow(DRIVE_PIN(i));
+    }
+    for (uint8_t i = 0; i < SENSE_PIN_COUNT; i++) {
+        if (SENSE_PIN(i) == NO_PIN) continue;
+        setPinInputHigh(SENSE_PIN(i));
+    }
+    matrix_io_delay();
+
+    for (uint8_t i = 0; i < SENSE_PIN_COUNT; i++) {
+        if (SENSE_PIN(i) != NO_PIN && !readPin(SENSE_PIN(i))) {
+            for (uint8_t j = 0; j < DRIVE_PIN_COUNT; j++) {
+                if (DRIVE_PIN(j) != NO_PIN) setPinInputHigh(DRIVE_PIN(j));
+            }
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < SENSE_PIN_COUNT; i++) {
+        if (SENSE_PIN(i) == NO_PIN) continue;
+        palEnableLineEvent(SENSE_PIN(i), PAL_EVENT_MODE_FALLING_EDGE);
+    }
+    return true;
 }
 
+/** \brief Put the pins back the way the matrix scan expects them
+ */
+void suspend_sleep_disarm(void) {
+    for (uint8_t i = 0; i < SENSE_PIN_COUNT; i++) {
+        if (SENSE_PIN(i) == NO_PIN) continue;
+        palDisableLineEvent(SENSE_PIN(i));
+    }
+    for (uint8_t i = 0; i < DRIVE_PIN_COUNT; i++) {
+        if (DRIVE_PIN(i) == NO_PIN) continue;
+        setPinInputHigh(DRIVE_PIN(i));
+    }
+}
+
+/** \brief Sleep until a key is pressed or the host resumes the bus
+ *
+ * This is stop mode: every clock is stopped, the key EXTI lines and the USB
+ * wakeup line (EXTI 18) wake the MCU up, and the PLL is started again before
+ * any interrupt handler runs.
+ */
+void suspend_sleep_enter(void) {
+    rccEnablePWRInterface(true);
+    PWR->CR &= ~PWR_CR_PDDS;
+    PWR->CR |= PWR_CR_LPDS;
+    EXTI->RTSR |= EXTI_RTSR_TR18;
+    EXTI->EMR |= EXTI_EMR_MR18;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+
+    // Pending interrupts wake the core up without being served, until the clocks are back
+    SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
+    __disable_irq();
+    __SEV();
+    __WFE();  // clears the event register
+    __WFE();
+    SCB->SCR &= ~(SCB_SCR_SLEEPDEEP_Msk | SCB_SCR_SEVONPEND_Msk);
+
+    EXTI->EMR &= ~EXTI_EMR_MR18;
+    // stop mode leaves the MCU running from the HSI
+    stm32_clock_init();
+    __enable_irq();
+}
+#else
+bool suspend_sleep_arm(void) { return false; }
+
+void suspend_sleep_enter(void) {}
+
+void suspend_sleep_disarm(void) {}
+#endif
+
+void suspend_sleep_idle(void) { wait_ms(17); }
+
+/** \brief suspend power down
+ *
+ * Turns the peripherals off, then sleeps until a key is pressed when
+ * SUSPEND_LOW_POWER is defined, or for 17ms otherwise.
+ */
+void suspend_power_down(void) { suspend_state_power_down(); }
+
 /** \brief suspend wakeup condition
  *
  * FIXME: needs doc
@@ -91,9 +226,9 @@ bool                       suspend_wakeup_condition(void) {
     matrix_scan();
     matrix_power_down();
     for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
-        if (matrix_get_row(r)) return true;
+        if (matrix_get_row(r)) return suspend_state_wakeup_condition(true);
     }
-    return false;
+    return suspend_state_wakeup_condition(false);
 }
 
 /** \brief run user level code immediately after wakeup
@@ -42,6 +42,21 @@ uint32_t timer_read32(void) {
 #endif
 }
 
+uint32_t timer_read_us32(void) {
+    uint32_t systime = (uint32_t)chVTGetSystemTime();
+
+#if CH_CFG_ST_RESOLUTION < 32
+    if (systime < last_systime) {
+        overflow += ((uint32_t)1) << CH_CFG_ST_RESOLUTION;
+    }
+
+    last_systime = systime;
+    return (uint32_t)TIME_I2US(systime - reset_point + overflow);
+#else
+    return (uint32_t)TIME_I2US(systime - reset_point);
+#endif
+}
+
 uint16_t timer_elapsed(uint16_t last) { return TIMER_DIFF_16(timer_read(), last); }
 
 uint32_t timer_elapsed32(uint32_t last) { return TIMER_DIFF_32(timer_read32(), last); }
@@ -53,7 +53,41 @@ extern debug_config_t debug_config;
 /*
  * Debug print utils
  */
-#ifndef NO_DEBUG
+#if !defined(NO_DEBUG) && defined(DEFERRED_DEBUG_ENABLE)
+
+#    include "debug_log.h"
+
+/* Formatted on the host, see debug_log.h */
+#    define dprintf(fmt, ...)                                            \
+        do {                                                             \
+            if (debug_enable) debug_log_write(PSTR(fmt), ##__VA_ARGS__); \
+        } while (0)
+// Plain strings are sent as the argument of a "%s" record, so they may be any pointer and hold a %
+#    define dprint(s) dprintf("%s", s)
+#    define dprintln(s) dprintf("%s\r\n", s)
+#    define dmsg(s) dprintf(__FILE__ " at %u: " s "\n", __LINE__)
+
+/* Deprecated. DO NOT USE these anymore, use dprintf instead. */
+#    define debug(s) dprintf("%s", s)
+#    define debugln(s) dprintf("%s\r\n", s)
+#    define debug_msg(s) dprintf(__FILE__ " at %u in : " s, __LINE__)
+#    define debug_dec(data) dprintf("%u", data)
+#    define debug_decs(data) dprintf("%d", data)
+#    define debug_hex4(data) dprintf("%X", data)
+#    define debug_hex8(data) dprintf("%02X", data)
+#    define debug_hex16(data) dprintf("%04X", data)
+#    define debug_hex32(data) dprintf("%08lX", data)
+#    define debug_bin8(data) dprintf("%08b", data)
+#    define debug_bin16(data) dprintf("%016b", data)
+#    define debug_bin32(data) dprintf("%032lb", data)
+#    define debug_bin_reverse8(data) dprintf("%08b", bitrev(data))
+#    define debug_bin_reverse16(data) dprintf("%016b", bitrev16(data))
+#    define debug_bin_reverse32(data) dprintf("%032lb", bitrev32(data))
+#    define debug_hex(data) debug_hex8(data)
+#    define debug_bin(data) debug_bin8(data)
+#    define debug_bin_reverse(data) debug_bin8(data)
+
+#elif !defined(NO_DEBUG)
 
 #    define dprint(s)                   \
         do {                            \
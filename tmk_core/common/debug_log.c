@@ -0,0 +1,133 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "debug_log.h"
+#include "sendchar.h"
+
+#if DEBUG_LOG_RECORD_SIZE > 252
+#    error "DEBUG_LOG_RECORD_SIZE must be at most 252"
+#endif
+
+typedef struct {
+    uint8_t data[DEBUG_LOG_RECORD_SIZE];
+    uint8_t length;
+} debug_log_record_t;
+
+static void debug_log_append(debug_log_record_t *record, const void *value, uint8_t size) {
+    const uint8_t *bytes = value;
+
+    for (uint8_t i = 0; i < size && record->length < DEBUG_LOG_RECORD_SIZE; i++) {
+        record->data[record->length++] = bytes[i];
+    }
+}
+
+static void debug_log_append_string(debug_log_record_t *record, const char *str, bool progmem) {
+    if (str == NULL) {
+        str     = PSTR("(null)");
+        progmem = true;
+    }
+
+    // Always leave room for the terminator, so that the host can tell where the string ends
+    for (char c; record->length < DEBUG_LOG_RECORD_SIZE - 1 && (c = progmem ? pgm_read_byte(str) : *str) != '\0'; str++) {
+        record->data[record->length++] = c;
+    }
+    if (record->length < DEBUG_LOG_RECORD_SIZE) {
+        record->data[record->length++] = '\0';
+    }
+}
+
+/* Sends the record COBS encoded, so that it contains no zero bytes. */
+static void debug_log_send(const debug_log_record_t *record) {
+    uint8_t encoded[DEBUG_LOG_RECORD_SIZE + 2];
+    uint8_t code_index = 0;
+    uint8_t length     = 1;
+    uint8_t code       = 1;
+
+    for (uint8_t i = 0; i < record->length; i++) {
+        if (record->data[i] == 0) {
+            encoded[code_index] = code;
+            code_index          = length++;
+            code                = 1;
+        } else {
+            encoded[length++] = record->data[i];
+            if (++code == 0xFF) {
+                encoded[code_index] = code;
+                code_index          = length++;
+                code                = 1;
+            }
+        }
+    }
+    encoded[code_index] = code;
+
+    sendchar(DEBUG_LOG_RECORD_START);
+    sendchar(length);
+    for (uint8_t i = 0; i < length; i++) {
+        sendchar(encoded[i]);
+    }
+}
+
+void debug_log_write(PGM_P fmt, ...) {
+    debug_log_record_t record = {.length = 0};
+    va_list            args;
+
+    debug_log_append(&record, &fmt, sizeof(fmt));
+
+    // Only the argument sizes are needed here, so the conversions are skipped over rather than parsed
+    va_start(args, fmt);
+    for (char c; (c = pgm_read_byte(fmt)) != '\0'; fmt++) {
+        if (c != '%') {
+            continue;
+        }
+
+        bool is_long = false;
+        while ((c = pgm_read_byte(++fmt)) != '\0') {
+            if (c == 'l') {
+                is_long = true;
+            } else if (c == '*') {
+                int width = va_arg(args, int);
+                debug_log_append(&record, &width, sizeof(width));
+            } else if (!(c == '-' || c == '+' || c == ' ' || c == '#' || c == '.' || c == 'h' || (c >= '0' && c <= '9'))) {
+                break;
+            }
+        }
+
+        if (c == '\0') {
+            break;
+        } else if (c == 's' || c == 'S') {
+            debug_log_append_string(&record, va_arg(args, const char *), c == 'S');
+        } else if (c == 'c') {
+            uint8_t value = va_arg(args, int);
+            debug_log_append(&record, &value, sizeof(value));
+        } else if (c == 'p') {
+            void *value = va_arg(args, void *);
+            debug_log_append(&record, &value, sizeof(value));
+        } else if (c != '%') {
+            if (is_long) {
+                uint32_t value = va_arg(args, unsigned long);
+                debug_log_append(&record, &value, sizeof(value));
+            } else {
+                unsigned int value = va_arg(args, unsigned int);
+                debug_log_append(&record, &value, sizeof(value));
+            }
+        }
+    }
+    va_end(args);
+
+    debug_log_send(&record);
+}
@@ -0,0 +1,46 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "progmem.h"
+
+/*
+ * Deferred debug logging
+ *
+ * Instead of being formatted on the keyboard, each dprintf() sends a record
+ * holding the address of its format string and the raw argument values. The
+ * host looks the format string up in the firmware's ELF file and formats the
+ * message itself (see `qmk decode-log`).
+ *
+ * A record is DEBUG_LOG_RECORD_START, a length byte, and that many bytes of
+ * COBS encoded payload:
+ *   format string address (sizeof(PGM_P) bytes, little endian)
+ *   each argument in order:
+ *     %c              1 byte
+ *     %s, %S          the characters, NUL terminated
+ *     %p              sizeof(void *) bytes
+ *     %l.             4 bytes
+ *     others, and *   sizeof(int) bytes
+ * The encoding keeps zero bytes out of the console stream, where they are
+ * taken as padding.
+ */
+#define DEBUG_LOG_RECORD_START 0x1E
+
+#ifndef DEBUG_LOG_RECORD_SIZE
+#    define DEBUG_LOG_RECORD_SIZE 64
+#endif
+
+void debug_log_write(PGM_P fmt, ...);
@@ -31,6 +31,14 @@ static host_driver_t *driver;
 static uint16_t       last_system_report   = 0;
 static uint16_t       last_consumer_report = 0;
 
+#ifdef MOUSE_HIRES_SCROLL
+report_mouse_resolution_t mouse_resolution_report = {
+#    ifdef MOUSE_SHARED_EP
+    .report_id = REPORT_ID_MOUSE,
+#    endif
+};
+#endif
+
 void host_set_driver(host_driver_t *d) { driver = d; }
 
 host_driver_t *host_get_driver(void) { return driver; }
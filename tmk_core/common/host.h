@@ -36,6 +36,10 @@ extern "C" {
 extern uint8_t keyboard_idle;
 extern uint8_t keyboard_protocol;
 
+#ifdef MOUSE_HIRES_SCROLL
+extern report_mouse_resolution_t mouse_resolution_report;
+#endif
+
 /* host driver */
 void           host_set_driver(host_driver_t *driver);
 host_driver_t *host_get_driver(void);
@@ -420,6 +420,7 @@ MATRIX_LOOP_END:
 
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
+    rgblight_flush();
 #endif
 
 #ifdef RGB_MATRIX_ENABLE
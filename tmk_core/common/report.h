@@ -177,17 +177,45 @@ typedef struct {
     uint16_t usage;
 } __attribute__((packed)) report_extra_t;
 
+#ifdef MOUSE_EXTENDED_REPORT
+typedef int16_t mouse_xy_report_t;
+#    define MOUSE_REPORT_XY_MIN -32767
+#    define MOUSE_REPORT_XY_MAX 32767
+#else
+typedef int8_t mouse_xy_report_t;
+#    define MOUSE_REPORT_XY_MIN -127
+#    define MOUSE_REPORT_XY_MAX 127
+#endif
+
 typedef struct {
 #ifdef MOUSE_SHARED_EP
     uint8_t report_id;
 #endif
-    uint8_t buttons;
-    int8_t  x;
-    int8_t  y;
-    int8_t  v;
-    int8_t  h;
+    uint8_t           buttons;
+    mouse_xy_report_t x;
+    mouse_xy_report_t y;
+    int8_t            v;
+    int8_t            h;
 } __attribute__((packed)) report_mouse_t;
 
+#ifdef MOUSE_HIRES_SCROLL
+#    ifndef MOUSE_HIRES_SCROLL_MULTIPLIER
+#        define MOUSE_HIRES_SCROLL_MULTIPLIER 120
+#    endif
+#    if MOUSE_HIRES_SCROLL_MULTIPLIER < 2 || MOUSE_HIRES_SCROLL_MULTIPLIER > 127
+#        error "MOUSE_HIRES_SCROLL_MULTIPLIER must be between 2 and 127"
+#    endif
+
+/* Feature report of the wheel resolution multipliers, set by the host */
+typedef struct {
+#    ifdef MOUSE_SHARED_EP
+    uint8_t report_id;
+#    endif
+    uint8_t v;  // 1 if the host uses MOUSE_HIRES_SCROLL_MULTIPLIER for the vertical wheel, 0 otherwise
+    uint8_t h;  // same for the horizontal wheel
+} __attribute__((packed)) report_mouse_resolution_t;
+#endif
+
 typedef struct {
 #if JOYSTICK_AXES_COUNT > 0
 #    if JOYSTICK_AXES_RESOLUTION > 8
@@ -0,0 +1,87 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "suspend_state.h"
+#include "timer.h"
+#include "debug.h"
+
+static suspend_state_t state = SUSPEND_STATE_AWAKE;
+static bool            woken_up;  // left the sleep, the matrix has not been scanned yet
+static bool            waking;    // wakeup_timer runs since the MCU was woken up
+static bool            resumed;
+static uint32_t        wakeup_timer;
+static uint32_t        wakeup_time;
+static uint16_t        false_wakeups;
+
+suspend_state_t suspend_state_get(void) { return state; }
+
+void suspend_state_power_down(void) {
+    if (state == SUSPEND_STATE_AWAKE) {
+        suspend_sleep_peripherals_off();
+        state         = SUSPEND_STATE_SUSPENDED;
+        woken_up      = false;
+        waking        = false;
+        false_wakeups = 0;
+    }
+
+    if (!suspend_sleep_arm()) {
+        suspend_sleep_idle();
+        return;
+    }
+
+    state = SUSPEND_STATE_SLEEPING;
+    suspend_sleep_enter();
+    suspend_sleep_disarm();
+    state = SUSPEND_STATE_SUSPENDED;
+
+    woken_up     = true;
+    waking       = true;
+    wakeup_timer = timer_read32();
+}
+
+bool suspend_state_wakeup_condition(bool key_pressed) {
+    if (woken_up && !key_pressed) {
+        // noise, a released key, the host or another interrupt
+        false_wakeups++;
+    }
+    woken_up = false;
+    return key_pressed;
+}
+
+void suspend_state_wakeup(void) {
+    if (state == SUSPEND_STATE_AWAKE) return;
+
+    if (!waking) {
+        // the host resumed the bus while the MCU was running
+        wakeup_timer = timer_read32();
+    }
+    state    = SUSPEND_STATE_AWAKE;
+    woken_up = false;
+    waking   = false;
+    resumed  = true;
+}
+
+void suspend_state_report_sent(void) {
+    if (!resumed) return;
+
+    resumed     = false;
+    wakeup_time = timer_elapsed32(wakeup_timer);
+    dprintf("suspend: first report %lums after waking up, %u false wakeups\n", (unsigned long)wakeup_time, false_wakeups);
+}
+
+uint32_t suspend_state_wakeup_time(void) { return wakeup_time; }
+
+uint16_t suspend_state_false_wakeups(void) { return false_wakeups; }
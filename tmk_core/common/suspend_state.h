@@ -0,0 +1,79 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Platform independent part of USB suspend, for the platforms that can sleep
+ * until a key is pressed. The main loop calls suspend_power_down() and
+ * suspend_wakeup_condition() while the bus is suspended, and the platform
+ * forwards them here:
+ *
+ *   AWAKE --(power down)--> SUSPENDED --(keys armed)--> SLEEPING
+ *     ^                       ^   |                        |
+ *     |                       |   +--(can't arm)--> idle   |
+ *     |                       +------(woken up)------------+
+ *     +--(host resumes the bus)--- SUSPENDED
+ */
+
+typedef enum {
+    SUSPEND_STATE_AWAKE,      // the bus is active
+    SUSPEND_STATE_SUSPENDED,  // peripherals are off, the MCU is running
+    SUSPEND_STATE_SLEEPING,   // the MCU is stopped until a key press or the host wakes it up
+} suspend_state_t;
+
+suspend_state_t suspend_state_get(void);
+
+/**
+ * Turns the peripherals off on the first call after the bus is suspended, then
+ * sleeps until a key is pressed, or just idles if the keys can't wake the MCU.
+ */
+void suspend_state_power_down(void);
+
+/**
+ * Records the result of the matrix scan done after waking up, and passes it through.
+ */
+bool suspend_state_wakeup_condition(bool key_pressed);
+
+/**
+ * Called when the host resumes the bus, before the first report is sent.
+ */
+void suspend_state_wakeup(void);
+
+/**
+ * Called once the first report after resuming has been sent, to measure the wake up time.
+ */
+void suspend_state_report_sent(void);
+
+/**
+ * @return the time in milliseconds from waking up to the first report, of the last resume
+ */
+uint32_t suspend_state_wakeup_time(void);
+
+/**
+ * @return the number of times the MCU woke up without a key being pressed, since the bus was suspended
+ */
+uint16_t suspend_state_false_wakeups(void);
+
+// Implemented by the platform
+void suspend_sleep_peripherals_off(void);
+bool suspend_sleep_arm(void);  // false if the keys can't wake the MCU, for instance while one is held down
+void suspend_sleep_enter(void);
+void suspend_sleep_disarm(void);
+void suspend_sleep_idle(void);
@@ -0,0 +1,6 @@
+suspend_state_DEFS := -DNO_DEBUG
+
+suspend_state_SRC := \
+	$(TMK_PATH)/common/tests/suspend_state_tests.cpp \
+	$(TMK_PATH)/common/suspend_state.c \
+	$(TMK_PATH)/common/test/timer.c
@@ -0,0 +1,190 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "suspend_state.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// The platform, mocked
+static std::vector<std::string> calls;
+static bool                     can_arm;
+static uint32_t                 sleep_time;
+static suspend_state_t          state_while_sleeping;
+
+extern "C" {
+void suspend_sleep_peripherals_off(void) { calls.push_back("off"); }
+bool suspend_sleep_arm(void) {
+    calls.push_back("arm");
+    return can_arm;
+}
+void suspend_sleep_enter(void) {
+    calls.push_back("enter");
+    state_while_sleeping = suspend_state_get();
+    advance_time(sleep_time);
+}
+void suspend_sleep_disarm(void) { calls.push_back("disarm"); }
+void suspend_sleep_idle(void) {
+    calls.push_back("idle");
+    advance_time(17);
+}
+}
+
+class SuspendState : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        suspend_state_wakeup();
+        suspend_state_report_sent();
+        calls.clear();
+        can_arm              = true;
+        sleep_time           = 0;
+        state_while_sleeping = SUSPEND_STATE_AWAKE;
+        set_time(0);
+    }
+};
+
+TEST_F(SuspendState, SleepsUntilWokenUp) {
+    suspend_state_power_down();
+    EXPECT_EQ(calls, (std::vector<std::string>{"off", "arm", "enter", "disarm"}));
+    EXPECT_EQ(state_while_sleeping, SUSPEND_STATE_SLEEPING);
+    EXPECT_EQ(suspend_state_get(), SUSPEND_STATE_SUSPENDED);
+}
+
+TEST_F(SuspendState, PowersDownOncePerSuspend) {
+    for (int i = 0; i < 3; i++) {
+        suspend_state_power_down();
+        EXPECT_FALSE(suspend_state_wakeup_condition(false));
+    }
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), "off"), 1);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), "enter"), 3);
+
+    suspend_state_wakeup();
+    EXPECT_EQ(suspend_state_get(), SUSPEND_STATE_AWAKE);
+    suspend_state_power_down();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), "off"), 2);
+}
+
+TEST_F(SuspendState, IdlesWhenKeysCannotWake) {
+    can_arm = false;
+    suspend_state_power_down();
+    EXPECT_EQ(calls, (std::vector<std::string>{"off", "arm", "idle"}));
+    EXPECT_EQ(suspend_state_get(), SUSPEND_STATE_SUSPENDED);
+
+    // a held key is released
+    can_arm = true;
+    calls.clear();
+    suspend_state_power_down();
+    EXPECT_EQ(calls, (std::vector<std::string>{"arm", "enter", "disarm"}));
+}
+
+TEST_F(SuspendState, CountsFalseWakeups) {
+    suspend_state_power_down();
+    EXPECT_FALSE(suspend_state_wakeup_condition(false));
+    suspend_state_power_down();
+    EXPECT_FALSE(suspend_state_wakeup_condition(false));
+    EXPECT_EQ(suspend_state_false_wakeups(), 2);
+
+    suspend_state_power_down();
+    EXPECT_TRUE(suspend_state_wakeup_condition(true));
+    EXPECT_EQ(suspend_state_false_wakeups(), 2);
+
+    // idling doesn't wake up, so scanning without a key isn't a false wakeup
+    can_arm = false;
+    suspend_state_power_down();
+    EXPECT_FALSE(suspend_state_wakeup_condition(false));
+    EXPECT_EQ(suspend_state_false_wakeups(), 2);
+
+    // counted per suspend
+    suspend_state_wakeup();
+    suspend_state_power_down();
+    EXPECT_EQ(suspend_state_false_wakeups(), 0);
+}
+
+TEST_F(SuspendState, MeasuresWakeupFromKeyPress) {
+    sleep_time = 60000;
+    suspend_state_power_down();
+    advance_time(2);
+    EXPECT_TRUE(suspend_state_wakeup_condition(true));
+
+    // the host takes a while to resume after the remote wakeup
+    advance_time(20);
+    suspend_state_wakeup();
+    advance_time(3);
+    suspend_state_report_sent();
+    EXPECT_EQ(suspend_state_wakeup_time(), 25);
+
+    // only the first report counts
+    advance_time(100);
+    suspend_state_report_sent();
+    EXPECT_EQ(suspend_state_wakeup_time(), 25);
+}
+
+TEST_F(SuspendState, MeasuresWakeupFromHost) {
+    can_arm = false;
+    suspend_state_power_down();
+    suspend_state_wakeup_condition(false);
+    advance_time(1000);
+
+    suspend_state_wakeup();
+    advance_time(4);
+    suspend_state_report_sent();
+    EXPECT_EQ(suspend_state_wakeup_time(), 4);
+}
+
+TEST_F(SuspendState, IgnoresWakeupWhileAwake) {
+    uint32_t wakeup_time = suspend_state_wakeup_time();
+    suspend_state_wakeup();
+    EXPECT_EQ(suspend_state_get(), SUSPEND_STATE_AWAKE);
+    advance_time(10);
+    suspend_state_report_sent();
+    EXPECT_EQ(suspend_state_wakeup_time(), wakeup_time);
+    EXPECT_TRUE(calls.empty());
+}
+
+TEST_F(SuspendState, MeasuresEveryResume) {
+    // as in the main loop: the wakeup is recorded once the bus is resumed, then the report is sent
+    for (uint32_t delay = 5; delay <= 15; delay += 10) {
+        sleep_time = 60000;
+        suspend_state_power_down();
+        EXPECT_TRUE(suspend_state_wakeup_condition(true));
+        advance_time(delay);
+        suspend_state_wakeup();
+        suspend_state_report_sent();
+        EXPECT_EQ(suspend_state_wakeup_time(), delay);
+    }
+}
+
+TEST_F(SuspendState, ReportsNothingBeforeTheWakeup) {
+    uint32_t wakeup_time = suspend_state_wakeup_time();
+    sleep_time           = 60000;
+    suspend_state_power_down();
+    EXPECT_TRUE(suspend_state_wakeup_condition(true));
+    advance_time(7);
+    suspend_state_report_sent();
+    EXPECT_EQ(suspend_state_wakeup_time(), wakeup_time);
+
+    suspend_state_wakeup();
+    suspend_state_report_sent();
+    EXPECT_EQ(suspend_state_wakeup_time(), 7);
+}
@@ -0,0 +1 @@
+TEST_LIST += suspend_state
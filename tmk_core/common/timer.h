@@ -43,6 +43,11 @@ uint32_t timer_read32(void);
 uint16_t timer_elapsed(uint16_t last);
 uint32_t timer_elapsed32(uint32_t last);
 
+// Microsecond counter for profiling. Resolution depends on the platform (system tick on ChibiOS,
+// timer 0 on AVR, 1ms on ATSAM), and it wraps every ~71 minutes.
+uint32_t timer_read_us32(void);
+#define timer_elapsed_us32(last) TIMER_DIFF_32(timer_read_us32(), last)
+
 // Utility functions to check if a future time has expired & autmatically handle time wrapping if checked / reset frequently (half of max value)
 #define timer_expired(current, future) ((uint16_t)(current - future) < UINT16_MAX / 2)
 #define timer_expired32(current, future) ((uint32_t)(current - future) < UINT32_MAX / 2)
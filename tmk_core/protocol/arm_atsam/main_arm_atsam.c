@@ -31,6 +31,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // From keyboard's directory
 #include "config_led.h"
 
+#ifdef MOUSE_EXTENDED_REPORT
+#    error The ATSAM mouse report does not support MOUSE_EXTENDED_REPORT
+#endif
+
 uint8_t g_usb_state = USB_FSMSTATUS_FSMSTATE_OFF_Val;  // Saved USB state from hardware value to detect changes
 
 void    main_subtasks(void);
@@ -60,9 +60,13 @@ uint8_t gcr_desired;
 uint8_t gcr_actual;
 uint8_t gcr_actual_last;
 #    ifdef USE_MASSDROP_CONFIGURATOR
-uint8_t gcr_breathe;
-float   breathe_mult;
-float   pomod;
+uint8_t  gcr_breathe;
+uint32_t breathe_mult;
+int32_t  pomod;
+
+// Pattern positions of each LED along x and y, computed once in init()
+static int32_t led_po_x[ISSI3733_LED_COUNT];
+static int32_t led_po_y[ISSI3733_LED_COUNT];
 #    endif
 
 #    define ACT_GCR_NONE 0
@@ -222,6 +226,13 @@ static void init(void) {
 
     md_rgb_matrix_prepare();
 
+#    ifdef USE_MASSDROP_CONFIGURATOR
+    for (uint8_t i = 0; i < ISSI3733_LED_COUNT; i++) {
+        led_po_x[i] = led_pattern_position(g_led_config.point[i].x, 224);
+        led_po_y[i] = led_pattern_position(g_led_config.point[i].y, 64);
+    }
+#    endif
+
     gcr_min_counter = 0;
     v_5v_cat_hit    = 0;
 
@@ -251,7 +262,7 @@ static void flush(void) {
     }
 
 #    ifdef USE_MASSDROP_CONFIGURATOR
-    breathe_mult = 1;
+    breathe_mult = 65536;
 
     if (led_animation_breathing) {
         //+60us 119 LED
@@ -262,19 +273,11 @@ static void flush(void) {
         else if (led_animation_breathe_cur <= BREATHE_MIN_STEP)
             breathe_dir = 1;
 
-        // Brightness curve created for 256 steps, 0 - ~98%
-        breathe_mult = 0.000015 * led_animation_breathe_cur * led_animation_breathe_cur;
-        if (breathe_mult > 1)
-            breathe_mult = 1;
-        else if (breathe_mult < 0)
-            breathe_mult = 0;
+        breathe_mult = led_pattern_breathe(led_animation_breathe_cur);
     }
 
     // This should only be performed once per frame
-    pomod = (float)((g_rgb_timer / 10) % (uint32_t)(1000.0f / led_animation_speed)) / 10.0f * led_animation_speed;
-    pomod *= 100.0f;
-    pomod = (uint32_t)pomod % 10000;
-    pomod /= 100.0f;
+    pomod = led_pattern_offset(g_rgb_timer, led_animation_speed);
 
 #    endif  // USE_MASSDROP_CONFIGURATOR
 
@@ -342,68 +345,10 @@ uint8_t led_enabled               = 1;
 uint8_t led_animation_breathe_cur = BREATHE_MIN_STEP;
 uint8_t breathe_dir               = 1;
 
-static void led_run_pattern(led_setup_t* f, float* ro, float* go, float* bo, float pos) {
-    float po;
-
-    while (f->end != 1) {
-        po = pos;  // Reset po for new frame
-
-        // Add in any moving effects
-        if ((!led_animation_direction && f->ef & EF_SCR_R) || (led_animation_direction && (f->ef & EF_SCR_L))) {
-            po -= pomod;
-
-            if (po > 100)
-                po -= 100;
-            else if (po < 0)
-                po += 100;
-        } else if ((!led_animation_direction && f->ef & EF_SCR_L) || (led_animation_direction && (f->ef & EF_SCR_R))) {
-            po += pomod;
-
-            if (po > 100)
-                po -= 100;
-            else if (po < 0)
-                po += 100;
-        }
-
-        // Check if LED's po is in current frame
-        if (po < f->hs) {
-            f++;
-            continue;
-        }
-        if (po > f->he) {
-            f++;
-            continue;
-        }
-        // note: < 0 or > 100 continue
-
-        // Calculate the po within the start-stop percentage for color blending
-        po = (po - f->hs) / (f->he - f->hs);
-
-        // Add in any color effects
-        if (f->ef & EF_OVER) {
-            *ro = (po * (f->re - f->rs)) + f->rs;  // + 0.5;
-            *go = (po * (f->ge - f->gs)) + f->gs;  // + 0.5;
-            *bo = (po * (f->be - f->bs)) + f->bs;  // + 0.5;
-        } else if (f->ef & EF_SUBTRACT) {
-            *ro -= (po * (f->re - f->rs)) + f->rs;  // + 0.5;
-            *go -= (po * (f->ge - f->gs)) + f->gs;  // + 0.5;
-            *bo -= (po * (f->be - f->bs)) + f->bs;  // + 0.5;
-        } else {
-            *ro += (po * (f->re - f->rs)) + f->rs;  // + 0.5;
-            *go += (po * (f->ge - f->gs)) + f->gs;  // + 0.5;
-            *bo += (po * (f->be - f->bs)) + f->bs;  // + 0.5;
-        }
-
-        f++;
-    }
-}
-
 static void md_rgb_matrix_config_override(int i) {
-    float ro = 0;
-    float go = 0;
-    float bo = 0;
+    led_pattern_color_t color = {0, 0, 0};
 
-    float po = (led_animation_orientation) ? (float)g_led_config.point[i].y / 64.f * 100 : (float)g_led_config.point[i].x / 224.f * 100;
+    int32_t po = (led_animation_orientation) ? led_po_y[i] : led_po_x[i];
 
     uint8_t highest_active_layer = biton32(layer_state);
 
@@ -432,42 +377,22 @@ static void md_rgb_matrix_config_override(int i) {
             }
 
             if (led_cur_instruction->flags & LED_FLAG_USE_RGB) {
-                ro = led_cur_instruction->r;
-                go = led_cur_instruction->g;
-                bo = led_cur_instruction->b;
+                color.r = led_cur_instruction->r << 8;
+                color.g = led_cur_instruction->g << 8;
+                color.b = led_cur_instruction->b << 8;
             } else if (led_cur_instruction->flags & LED_FLAG_USE_PATTERN) {
-                led_run_pattern(led_setups[led_cur_instruction->pattern_id], &ro, &go, &bo, po);
+                led_run_pattern(led_setups[led_cur_instruction->pattern_id], &color, po, pomod, led_animation_direction);
             } else if (led_cur_instruction->flags & LED_FLAG_USE_ROTATE_PATTERN) {
-                led_run_pattern(led_setups[led_animation_id], &ro, &go, &bo, po);
+                led_run_pattern(led_setups[led_animation_id], &color, po, pomod, led_animation_direction);
             }
 
         next_iter:
             led_cur_instruction++;
         }
 
-        if (ro > 255)
-            ro = 255;
-        else if (ro < 0)
-            ro = 0;
-        if (go > 255)
-            go = 255;
-        else if (go < 0)
-            go = 0;
-        if (bo > 255)
-            bo = 255;
-        else if (bo < 0)
-            bo = 0;
-
-        if (led_animation_breathing) {
-            ro *= breathe_mult;
-            go *= breathe_mult;
-            bo *= breathe_mult;
-        }
     }
 
-    led_buffer[i].r = (uint8_t)ro;
-    led_buffer[i].g = (uint8_t)go;
-    led_buffer[i].b = (uint8_t)bo;
+    led_pattern_output(&color, breathe_mult, &led_buffer[i].r, &led_buffer[i].g, &led_buffer[i].b);
 }
 
 #    endif  // USE_MASSDROP_CONFIGURATOR
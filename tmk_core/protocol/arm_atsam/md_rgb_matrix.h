@@ -92,24 +92,7 @@ void md_rgb_matrix_indicators(void);
 
 #ifdef USE_MASSDROP_CONFIGURATOR
 
-#    define EF_NONE 0x00000000      // No effect
-#    define EF_OVER 0x00000001      // Overwrite any previous color information with new
-#    define EF_SCR_L 0x00000002     // Scroll left
-#    define EF_SCR_R 0x00000004     // Scroll right
-#    define EF_SUBTRACT 0x00000008  // Subtract color values
-
-typedef struct led_setup_s {
-    float    hs;   // Band begin at percent
-    float    he;   // Band end at percent
-    uint8_t  rs;   // Red start value
-    uint8_t  re;   // Red end value
-    uint8_t  gs;   // Green start value
-    uint8_t  ge;   // Green end value
-    uint8_t  bs;   // Blue start value
-    uint8_t  be;   // Blue end value
-    uint32_t ef;   // Animation and color effects
-    uint8_t  end;  // Set to signal end of the setup
-} led_setup_t;
+#    include "md_rgb_matrix_pattern.h"
 
 extern const uint8_t led_setups_count;
 extern void *        led_setups[];
@@ -0,0 +1,111 @@
+/*
+Copyright 2021 QMK
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef RGB_MATRIX_ENABLE
+#    ifdef USE_MASSDROP_CONFIGURATOR
+
+#        include "md_rgb_matrix_pattern.h"
+
+int32_t led_pattern_position(uint8_t coord, uint8_t span) { return ((uint32_t)coord * LED_PO_MAX + span / 2) / span; }
+
+int32_t led_pattern_offset(uint32_t timer, float speed) {
+    // Same steps as the original float code, kept to a hundredth of a percent
+    float pomod = (float)((timer / 10) % (uint32_t)(1000.0f / speed)) / 10.0f * speed;
+    return ((uint32_t)(pomod * 100.0f) % 10000) * LED_PO_SCALE;
+}
+
+uint32_t led_pattern_breathe(uint8_t breathe_cur) {
+    // Brightness curve created for 256 steps, 0 - ~98%: 0.000015 * cur^2 * 65536 = cur^2 * 3072 / 3125
+    uint32_t mult = ((uint32_t)breathe_cur * breathe_cur * 3072 + 1562) / 3125;
+    return mult > 65536 ? 65536 : mult;
+}
+
+void led_run_pattern(const led_setup_t *f, led_pattern_color_t *color, int32_t pos, int32_t pomod, uint8_t direction) {
+    int32_t po;
+
+    while (f->end != 1) {
+        po = pos;  // Reset po for new frame
+
+        // Add in any moving effects
+        if ((!direction && f->ef & EF_SCR_R) || (direction && (f->ef & EF_SCR_L))) {
+            po -= pomod;
+
+            if (po > LED_PO_MAX)
+                po -= LED_PO_MAX;
+            else if (po < 0)
+                po += LED_PO_MAX;
+        } else if ((!direction && f->ef & EF_SCR_L) || (direction && (f->ef & EF_SCR_R))) {
+            po += pomod;
+
+            if (po > LED_PO_MAX)
+                po -= LED_PO_MAX;
+            else if (po < 0)
+                po += LED_PO_MAX;
+        }
+
+        // Check if LED's po is in current frame
+        int32_t hs = (int32_t)f->hs_x100 * LED_PO_SCALE;
+        if (po < hs || po > (int32_t)f->he_x100 * LED_PO_SCALE) {
+            f++;
+            continue;
+        }
+
+        // Blend across the band: (po - hs) / (he - hs) * (end - start) + start, in 8.8
+        int32_t width = f->he_x100 - f->hs_x100;
+        int32_t rel   = po - hs;
+        int32_t r     = width ? rel * (f->re - f->rs) / width + (f->rs << 8) : (f->rs << 8);
+        int32_t g     = width ? rel * (f->ge - f->gs) / width + (f->gs << 8) : (f->gs << 8);
+        int32_t b     = width ? rel * (f->be - f->bs) / width + (f->bs << 8) : (f->bs << 8);
+
+        // Add in any color effects
+        if (f->ef & EF_OVER) {
+            color->r = r;
+            color->g = g;
+            color->b = b;
+        } else if (f->ef & EF_SUBTRACT) {
+            color->r -= r;
+            color->g -= g;
+            color->b -= b;
+        } else {
+            color->r += r;
+            color->g += g;
+            color->b += b;
+        }
+
+        f++;
+    }
+}
+
+// Truncates like the float code did, but where its rounding errors left a value just below a whole
+// number (229.996 for 230) this gets the whole number, so the two differ by one there
+static uint8_t led_pattern_channel(int32_t value, uint32_t breathe) {
+    if (value > (255 << 8))
+        value = 255 << 8;
+    else if (value < 0)
+        value = 0;
+
+    return ((uint32_t)value * breathe) >> 24;
+}
+
+void led_pattern_output(const led_pattern_color_t *color, uint32_t breathe, uint8_t *r, uint8_t *g, uint8_t *b) {
+    *r = led_pattern_channel(color->r, breathe);
+    *g = led_pattern_channel(color->g, breathe);
+    *b = led_pattern_channel(color->b, breathe);
+}
+
+#    endif  // USE_MASSDROP_CONFIGURATOR
+#endif      // RGB_MATRIX_ENABLE
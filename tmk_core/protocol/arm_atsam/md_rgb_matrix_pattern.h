@@ -0,0 +1,74 @@
+/*
+Copyright 2021 QMK
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+// Legacy Massdrop lighting pattern engine, integer only.
+//
+// Positions are expressed in hundredths of a percent of the board width (or height),
+// times LED_PO_SCALE, so that band limits and the scroll offset are exact and only the
+// per-LED positions, computed once, are rounded.
+// Colors are accumulated as 8.8 fixed point values.
+
+#define EF_NONE 0x00000000      // No effect
+#define EF_OVER 0x00000001      // Overwrite any previous color information with new
+#define EF_SCR_L 0x00000002     // Scroll left
+#define EF_SCR_R 0x00000004     // Scroll right
+#define EF_SUBTRACT 0x00000008  // Subtract color values
+
+#define LED_PO_SCALE 256
+#define LED_PO_MAX ((int32_t)10000 * LED_PO_SCALE)
+
+// Band limit from a percentage, evaluated at compile time: {.hs_x100 = LED_PO(16.67), ...}
+// The limits used to be float percentages named hs and he, the new names make old setups fail to build
+#define LED_PO(percent) ((uint16_t)((percent)*100 + 0.5))
+
+typedef struct led_setup_s {
+    uint16_t hs_x100;  // Band begin in hundredths of a percent, use LED_PO()
+    uint16_t he_x100;  // Band end in hundredths of a percent, use LED_PO()
+    uint8_t  rs;       // Red start value
+    uint8_t  re;       // Red end value
+    uint8_t  gs;       // Green start value
+    uint8_t  ge;       // Green end value
+    uint8_t  bs;       // Blue start value
+    uint8_t  be;       // Blue end value
+    uint32_t ef;       // Animation and color effects
+    uint8_t  end;      // Set to signal end of the setup
+} led_setup_t;
+
+typedef struct led_pattern_color_s {
+    int32_t r;
+    int32_t g;
+    int32_t b;
+} led_pattern_color_t;
+
+// Position of an LED from its g_led_config coordinate, where span is 224 for x and 64 for y
+int32_t led_pattern_position(uint8_t coord, uint8_t span);
+
+// Scroll offset from the animation timer, once per frame
+int32_t led_pattern_offset(uint32_t timer, float speed);
+
+// Breathing brightness multiplier, as a 0.16 fixed point value
+uint32_t led_pattern_breathe(uint8_t breathe_cur);
+
+// Blend the bands of a pattern into color for an LED at position po
+void led_run_pattern(const led_setup_t *f, led_pattern_color_t *color, int32_t po, int32_t pomod, uint8_t direction);
+
+// Clamp the accumulated color, apply the breathing multiplier and convert to 8 bit
+void led_pattern_output(const led_pattern_color_t *color, uint32_t breathe, uint8_t *r, uint8_t *g, uint8_t *b);
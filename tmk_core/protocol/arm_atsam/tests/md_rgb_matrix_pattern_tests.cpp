@@ -0,0 +1,225 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <math.h>
+#include <stdlib.h>
+
+extern "C" {
+#include "md_rgb_matrix_pattern.h"
+
+extern const uint8_t led_setups_count;
+extern void*         led_setups[];
+}
+
+// The float engine that md_rgb_matrix.c used before, as the reference
+struct Reference {
+    float   pomod;
+    float   breathe_mult;
+    uint8_t direction;
+    bool    breathing;
+
+    Reference(uint32_t timer, float speed, uint8_t breathe_cur, uint8_t direction) : direction(direction), breathing(breathe_cur != 0) {
+        pomod = (float)((timer / 10) % (uint32_t)(1000.0f / speed)) / 10.0f * speed;
+        pomod *= 100.0f;
+        pomod = (uint32_t)pomod % 10000;
+        pomod /= 100.0f;
+
+        breathe_mult = 0.000015 * breathe_cur * breathe_cur;
+        if (breathe_mult > 1)
+            breathe_mult = 1;
+        else if (breathe_mult < 0)
+            breathe_mult = 0;
+    }
+
+    void run_pattern(const led_setup_t* f, float* ro, float* go, float* bo, float pos) {
+        float po;
+
+        while (f->end != 1) {
+            po = pos;
+            float hs = f->hs_x100 / 100.0f;
+            float he = f->he_x100 / 100.0f;
+
+            if ((!direction && f->ef & EF_SCR_R) || (direction && (f->ef & EF_SCR_L))) {
+                po -= pomod;
+                if (po > 100)
+                    po -= 100;
+                else if (po < 0)
+                    po += 100;
+            } else if ((!direction && f->ef & EF_SCR_L) || (direction && (f->ef & EF_SCR_R))) {
+                po += pomod;
+                if (po > 100)
+                    po -= 100;
+                else if (po < 0)
+                    po += 100;
+            }
+
+            if (po < hs || po > he) {
+                f++;
+                continue;
+            }
+
+            po = (po - hs) / (he - hs);
+
+            if (f->ef & EF_OVER) {
+                *ro = (po * (f->re - f->rs)) + f->rs;
+                *go = (po * (f->ge - f->gs)) + f->gs;
+                *bo = (po * (f->be - f->bs)) + f->bs;
+            } else if (f->ef & EF_SUBTRACT) {
+                *ro -= (po * (f->re - f->rs)) + f->rs;
+                *go -= (po * (f->ge - f->gs)) + f->gs;
+                *bo -= (po * (f->be - f->bs)) + f->bs;
+            } else {
+                *ro += (po * (f->re - f->rs)) + f->rs;
+                *go += (po * (f->ge - f->gs)) + f->gs;
+                *bo += (po * (f->be - f->bs)) + f->bs;
+            }
+
+            f++;
+        }
+    }
+
+    // The channel value before it is truncated to 8 bit
+    static float channel(float value, float mult, bool breathing) {
+        if (value > 255)
+            value = 255;
+        else if (value < 0)
+            value = 0;
+        if (breathing) {
+            value *= mult;
+        }
+        return value;
+    }
+
+    void led(const led_setup_t* setup, uint8_t coord, uint8_t span, float* raw) {
+        float ro = 0, go = 0, bo = 0;
+        float po = (float)coord / (float)span * 100;
+        run_pattern(setup, &ro, &go, &bo, po);
+        raw[0] = channel(ro, breathe_mult, breathing);
+        raw[1] = channel(go, breathe_mult, breathing);
+        raw[2] = channel(bo, breathe_mult, breathing);
+    }
+
+    void led(const led_setup_t* setup, uint8_t coord, uint8_t span, uint8_t* rgb) {
+        float raw[3];
+        led(setup, coord, span, raw);
+        for (int c = 0; c < 3; c++) {
+            rgb[c] = (uint8_t)raw[c];
+        }
+    }
+};
+
+struct Fixed {
+    int32_t  pomod;
+    uint32_t breathe_mult;
+    uint8_t  direction;
+
+    Fixed(uint32_t timer, float speed, uint8_t breathe_cur, uint8_t direction) : direction(direction) {
+        pomod        = led_pattern_offset(timer, speed);
+        breathe_mult = breathe_cur ? led_pattern_breathe(breathe_cur) : 65536;
+    }
+
+    void led(const led_setup_t* setup, int32_t po, uint8_t* rgb) {
+        led_pattern_color_t color = {0, 0, 0};
+        led_run_pattern(setup, &color, po, pomod, direction);
+        led_pattern_output(&color, breathe_mult, &rgb[0], &rgb[1], &rgb[2]);
+    }
+};
+
+class MdRgbMatrixPattern : public ::testing::Test {};
+
+// The float engine's rounding errors can leave a channel just below the whole number that
+// the exact result is, like 229.9964 for 230, which it then truncates to 229. The fixed
+// point engine gets 230 there. Within this distance of a whole number the two may differ
+// by one, everywhere else they must be the same.
+static const float rounding_boundary = 1.0f / 128;
+
+TEST_F(MdRgbMatrixPattern, MatchesFloatEngine) {
+    uint32_t leds = 0, exact = 0, on_boundary = 0;
+
+    for (uint8_t p = 0; p < led_setups_count; p++) {
+        const led_setup_t* setup = (const led_setup_t*)led_setups[p];
+        for (uint32_t timer = 0; timer < 30000; timer += 37) {
+            for (uint8_t direction = 0; direction < 2; direction++) {
+                uint8_t   breathe_cur = (timer / 37) % 3 == 0 ? (timer / 7) % 256 : 0;
+                Reference reference(timer, 4.0f, breathe_cur, direction);
+                Fixed     fixed(timer, 4.0f, breathe_cur, direction);
+
+                for (uint8_t orientation = 0; orientation < 2; orientation++) {
+                    uint8_t span = orientation ? 64 : 224;
+                    for (uint16_t coord = 0; coord <= span; coord++) {
+                        float   raw[3];
+                        uint8_t actual[3];
+                        reference.led(setup, coord, span, raw);
+                        fixed.led(setup, led_pattern_position(coord, span), actual);
+
+                        bool same = true;
+                        for (int c = 0; c < 3; c++) {
+                            uint8_t expected = (uint8_t)raw[c];
+                            float   whole    = roundf(raw[c]);
+                            if (expected != actual[c] && fabsf(raw[c] - whole) < rounding_boundary) {
+                                EXPECT_TRUE(actual[c] == (uint8_t)whole || actual[c] == (uint8_t)(whole - 1)) << "pattern " << (int)p << " timer " << timer << " direction " << (int)direction << " coord " << coord << "/" << (int)span << " channel " << c << " float " << raw[c];
+                                on_boundary++;
+                            } else {
+                                EXPECT_EQ(expected, actual[c]) << "pattern " << (int)p << " timer " << timer << " direction " << (int)direction << " coord " << coord << "/" << (int)span << " channel " << c << " float " << raw[c];
+                            }
+                            same &= expected == actual[c];
+                        }
+                        exact += same;
+                        leds++;
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%u LEDs compared, %u identical, %u channels differ on a rounding boundary\n", leds, exact, on_boundary);
+}
+
+TEST_F(MdRgbMatrixPattern, FramesPerSecond) {
+    const uint32_t frames = 2000;
+    const uint32_t count  = 119;
+    uint8_t        rgb[3];
+    uint32_t       sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        Reference reference(frame * 16, 4.0f, frame % 256, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            reference.led((const led_setup_t*)led_setups[0], i * 224 / count, 224, rgb);
+            sink += rgb[0];
+        }
+    }
+    double reference_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int32_t positions[count];
+    for (uint32_t i = 0; i < count; i++) {
+        positions[i] = led_pattern_position(i * 224 / count, 224);
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        Fixed fixed(frame * 16, 4.0f, frame % 256, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            fixed.led((const led_setup_t*)led_setups[0], positions[i], rgb);
+            sink -= rgb[0];
+        }
+    }
+    double fixed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%u LED frames: fixed point %.0f fps, float %.0f fps (%u)\n", count, frames / fixed_s, frames / reference_s, sink);
+}
@@ -0,0 +1,7 @@
+md_rgb_matrix_pattern_DEFS := -DRGB_MATRIX_ENABLE -DUSE_MASSDROP_CONFIGURATOR
+md_rgb_matrix_pattern_INC := $(TMK_PATH)/protocol/arm_atsam
+
+md_rgb_matrix_pattern_SRC := \
+	$(TMK_PATH)/protocol/arm_atsam/tests/md_rgb_matrix_pattern_tests.cpp \
+	$(TMK_PATH)/protocol/arm_atsam/md_rgb_matrix_pattern.c \
+	$(TMK_PATH)/protocol/arm_atsam/md_rgb_matrix_programs.c
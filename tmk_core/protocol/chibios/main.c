@@ -58,6 +58,7 @@
 #    include "eeprom_driver.h"
 #endif
 #include "suspend.h"
+#include "suspend_state.h"
 #include "wait.h"
 
 /* -------------------------
@@ -243,8 +244,11 @@ int main(void) {
                 }
             }
             /* Woken up */
+            // the wakeup event is only handled on the next usb_event_queue_task(), so record it now
+            suspend_state_wakeup();
             // variables has been already cleared by the wakeup hook
             send_keyboard_report();
+            suspend_state_report_sent();
 #    ifdef MOUSEKEY_ENABLE
             mousekey_send();
 #    endif /* MOUSEKEY_ENABLE */
@@ -92,6 +92,7 @@ uint8_t extra_report_blank[3] = {0};
 #define HID_SET_REPORT 0x09
 #define HID_SET_IDLE 0x0A
 #define HID_SET_PROTOCOL 0x0B
+#define HID_REPORT_TYPE_FEATURE 0x03
 
 /*
  * Handles the GET_DESCRIPTOR callback
@@ -448,6 +449,11 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
 #if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
             usbInitEndpointI(usbp, MOUSE_IN_EPNUM, &mouse_ep_config);
 #endif
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+            /* The host enables high resolution scrolling again, if it wants to */
+            mouse_resolution_report.v = 0;
+            mouse_resolution_report.h = 0;
+#endif
 #ifdef SHARED_EP_ENABLE
             usbInitEndpointI(usbp, SHARED_IN_EPNUM, &shared_ep_config);
 #endif
@@ -530,6 +536,14 @@ static void    set_led_transfer_cb(USBDriver *usbp) {
     }
 }
 
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+static report_mouse_resolution_t set_resolution_buf;
+static void                      set_resolution_transfer_cb(USBDriver *usbp) {
+    mouse_resolution_report.v = set_resolution_buf.v;
+    mouse_resolution_report.h = set_resolution_buf.h;
+}
+#endif
+
 /* Callback for SETUP request on the endpoint 0 (control) */
 static bool usb_request_hook_cb(USBDriver *usbp) {
     const USBDescriptor *dp;
@@ -547,6 +561,12 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_DEV2HOST:
                 switch (usbp->setup[1]) { /* bRequest */
                     case HID_GET_REPORT:
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+                        if ((usbp->setup[4] == MOUSE_INTERFACE) && (usbp->setup[3] == HID_REPORT_TYPE_FEATURE)) { /* LSB(wIndex), MSB(wValue) */
+                            usbSetupTransfer(usbp, (uint8_t *)&mouse_resolution_report, sizeof(mouse_resolution_report), NULL);
+                            return TRUE;
+                        }
+#endif
                         switch (usbp->setup[4]) { /* LSB(wIndex) (check MSB==0?) */
                             case KEYBOARD_INTERFACE:
                                 usbSetupTransfer(usbp, (uint8_t *)&keyboard_report_sent, sizeof(keyboard_report_sent), NULL);
@@ -584,6 +604,12 @@ static bool usb_request_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_HOST2DEV:
                 switch (usbp->setup[1]) { /* bRequest */
                     case HID_SET_REPORT:
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+                        if ((usbp->setup[4] == MOUSE_INTERFACE) && (usbp->setup[3] == HID_REPORT_TYPE_FEATURE)) { /* LSB(wIndex), MSB(wValue) */
+                            usbSetupTransfer(usbp, (uint8_t *)&set_resolution_buf, sizeof(set_resolution_buf), set_resolution_transfer_cb);
+                            return TRUE;
+                        }
+#endif
                         switch (usbp->setup[4]) { /* LSB(wIndex) (check MSB==0?) */
                             case KEYBOARD_INTERFACE:
 #if defined(SHARED_EP_ENABLE) && !defined(KEYBOARD_SHARED_EP)
@@ -922,6 +948,64 @@ void send_consumer(uint16_t data) {
 #endif
 }
 
+/* ---------------------------------------------------------
+ *                 Transmit ring buffers
+ * ---------------------------------------------------------
+ */
+
+#if defined(CONSOLE_ENABLE) || defined(VIRTSER_ENABLE)
+
+/* Output is queued here and handed to the USB driver from the stream's task,
+ * so that printing never waits for the host. The size must be a power of two. */
+typedef struct {
+    uint8_t *buffer;
+    uint16_t size;
+    uint16_t head;
+    uint16_t tail;
+    uint16_t dropped;
+} usb_tx_ring_t;
+
+/* Queues all of the data, or none of it if it does not fit. */
+static bool usb_tx_ring_write(usb_tx_ring_t *ring, const uint8_t *data, uint16_t length) {
+    if (length > ring->size - (uint16_t)(ring->head - ring->tail)) {
+        if (ring->dropped < UINT16_MAX - length) {
+            ring->dropped += length;
+        } else {
+            ring->dropped = UINT16_MAX;
+        }
+        return false;
+    }
+
+    for (uint16_t i = 0; i < length; i++) {
+        ring->buffer[(ring->head + i) & (ring->size - 1)] = data[i];
+    }
+    ring->head += length;
+    return true;
+}
+
+/* Writes the queued data to the driver, at most one packet at a time, until it cannot take any more within the timeout. */
+static void usb_tx_ring_flush(usb_tx_ring_t *ring, QMKUSBDriver *driver, uint16_t packet_size, sysinterval_t timeout) {
+    while (ring->head != ring->tail) {
+        uint16_t start  = ring->tail & (ring->size - 1);
+        uint16_t length = ring->head - ring->tail;
+
+        if (length > ring->size - start) {
+            length = ring->size - start;
+        }
+        if (length > packet_size) {
+            length = packet_size;
+        }
+
+        size_t written = chnWriteTimeout(driver, &ring->buffer[start], length, timeout);
+        ring->tail += written;
+        if (written < length) {
+            break;
+        }
+    }
+}
+
+#endif
+
 /* ---------------------------------------------------------
  *                   Console functions
  * ---------------------------------------------------------
@@ -929,12 +1013,29 @@ void send_consumer(uint16_t data) {
 
 #ifdef CONSOLE_ENABLE
 
+#    ifndef CONSOLE_TX_BUFFER_SIZE
+#        define CONSOLE_TX_BUFFER_SIZE 256
+#    endif
+#    if (CONSOLE_TX_BUFFER_SIZE & (CONSOLE_TX_BUFFER_SIZE - 1)) != 0
+#        error "CONSOLE_TX_BUFFER_SIZE must be a power of two"
+#    endif
+#    ifndef CONSOLE_FLUSH_TIMEOUT
+#        define CONSOLE_FLUSH_TIMEOUT 100
+#    endif
+
+static uint8_t       console_tx_buffer[CONSOLE_TX_BUFFER_SIZE];
+static usb_tx_ring_t console_tx_ring = {console_tx_buffer, CONSOLE_TX_BUFFER_SIZE, 0, 0, 0};
+
 int8_t sendchar(uint8_t c) {
-    // The previous implmentation had timeouts, but I think it's better to just slow down
-    // and make sure that everything is transferred, rather than dropping stuff
-    return chnWrite(&drivers.console_driver.driver, &c, 1);
+    // Output that does not fit is dropped rather than waited for, so that
+    // debug output does not change the timing of the scan loop
+    return usb_tx_ring_write(&console_tx_ring, &c, 1) ? 0 : -1;
 }
 
+void console_flush_output(void) { usb_tx_ring_flush(&console_tx_ring, &drivers.console_driver.driver, CONSOLE_EPSIZE, TIME_MS2I(CONSOLE_FLUSH_TIMEOUT)); }
+
+uint16_t console_tx_dropped(void) { return console_tx_ring.dropped; }
+
 // Just a dummy function for now, this could be exposed as a weak function
 // Or connected to the actual QMK console
 static void console_receive(uint8_t *data, uint8_t length) {
@@ -943,6 +1044,8 @@ static void console_receive(uint8_t *data, uint8_t length) {
 }
 
 void console_task(void) {
+    usb_tx_ring_flush(&console_tx_ring, &drivers.console_driver.driver, CONSOLE_EPSIZE, TIME_IMMEDIATE);
+
     uint8_t buffer[CONSOLE_EPSIZE];
     size_t  size = 0;
     do {
@@ -1006,13 +1109,29 @@ void midi_ep_task(void) {
 
 #ifdef VIRTSER_ENABLE
 
-void virtser_send(const uint8_t byte) { chnWrite(&drivers.serial_driver.driver, &byte, 1); }
+#    ifndef VIRTSER_TX_BUFFER_SIZE
+#        define VIRTSER_TX_BUFFER_SIZE 128
+#    endif
+#    if (VIRTSER_TX_BUFFER_SIZE & (VIRTSER_TX_BUFFER_SIZE - 1)) != 0
+#        error "VIRTSER_TX_BUFFER_SIZE must be a power of two"
+#    endif
+
+static uint8_t       virtser_tx_buffer[VIRTSER_TX_BUFFER_SIZE];
+static usb_tx_ring_t virtser_tx_ring = {virtser_tx_buffer, VIRTSER_TX_BUFFER_SIZE, 0, 0, 0};
+
+void virtser_send(const uint8_t byte) { usb_tx_ring_write(&virtser_tx_ring, &byte, 1); }
+
+void virtser_send_buffer(const uint8_t *data, uint8_t length) { usb_tx_ring_write(&virtser_tx_ring, data, length); }
+
+uint16_t virtser_tx_dropped(void) { return virtser_tx_ring.dropped; }
 
 __attribute__((weak)) void virtser_recv(uint8_t c) {
     // Ignore by default
 }
 
 void virtser_task(void) {
+    usb_tx_ring_flush(&virtser_tx_ring, &drivers.serial_driver.driver, CDC_EPSIZE, TIME_IMMEDIATE);
+
     uint8_t numBytesReceived = 0;
     uint8_t buffer[16];
     do {
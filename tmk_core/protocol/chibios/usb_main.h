@@ -98,4 +98,14 @@ int8_t sendchar(uint8_t c);
 /* Flush output (send everything immediately) */
 void console_flush_output(void);
 
+/* Number of bytes dropped because the console transmit buffer was full */
+uint16_t console_tx_dropped(void);
+
 #endif /* CONSOLE_ENABLE */
+
+#ifdef VIRTSER_ENABLE
+
+/* Number of bytes dropped because the virtual serial transmit buffer was full */
+uint16_t virtser_tx_dropped(void);
+
+#endif /* VIRTSER_ENABLE */
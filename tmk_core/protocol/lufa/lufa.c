@@ -71,6 +71,9 @@ extern keymap_config_t keymap_config;
 #    else
 #        include "../serial.h"
 #    endif
+#    if defined(MOUSE_ENABLE) && defined(MOUSE_EXTENDED_REPORT)
+#        error The Bluetooth mouse reports do not support MOUSE_EXTENDED_REPORT
+#    endif
 #endif
 
 #ifdef VIRTSER_ENABLE
@@ -490,6 +493,12 @@ void EVENT_USB_Device_ConfigurationChanged(void) {
     ConfigSuccess &= Endpoint_ConfigureEndpoint((MOUSE_IN_EPNUM | ENDPOINT_DIR_IN), EP_TYPE_INTERRUPT, MOUSE_EPSIZE, 1);
 #endif
 
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+    /* The host enables high resolution scrolling again, if it wants to */
+    mouse_resolution_report.v = 0;
+    mouse_resolution_report.h = 0;
+#endif
+
 #ifdef SHARED_EP_ENABLE
     /* Setup shared report endpoint */
     ConfigSuccess &= Endpoint_ConfigureEndpoint((SHARED_IN_EPNUM | ENDPOINT_DIR_IN), EP_TYPE_INTERRUPT, SHARED_EPSIZE, 1);
@@ -564,6 +573,14 @@ void EVENT_USB_Device_ControlRequest(void) {
                         break;
                 }
 
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+                // the high byte of wValue is the report type, which is one more than the HID_ReportItemTypes_t
+                if (USB_ControlRequest.wIndex == MOUSE_INTERFACE && (USB_ControlRequest.wValue >> 8) == HID_REPORT_ITEM_Feature + 1) {
+                    ReportData = (uint8_t *)&mouse_resolution_report;
+                    ReportSize = sizeof(mouse_resolution_report);
+                }
+#endif
+
                 /* Write the report data to the control endpoint */
                 Endpoint_Write_Control_Stream_LE(ReportData, ReportSize);
                 Endpoint_ClearOUT();
@@ -571,6 +588,19 @@ void EVENT_USB_Device_ControlRequest(void) {
 
             break;
         case HID_REQ_SetReport:
+#if defined(MOUSE_ENABLE) && defined(MOUSE_HIRES_SCROLL)
+            if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE) && USB_ControlRequest.wIndex == MOUSE_INTERFACE && (USB_ControlRequest.wValue >> 8) == HID_REPORT_ITEM_Feature + 1) {
+                report_mouse_resolution_t report = {};
+
+                Endpoint_ClearSETUP();
+                Endpoint_Read_Control_Stream_LE(&report, MIN(USB_ControlRequest.wLength, sizeof(report)));
+                Endpoint_ClearIN();
+
+                mouse_resolution_report.v = report.v;
+                mouse_resolution_report.h = report.h;
+                break;
+            }
+#endif
             if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) {
                 // Interface
                 switch (USB_ControlRequest.wIndex) {
@@ -955,7 +985,13 @@ void virtser_task(void) {
  *
  * FIXME: Needs doc
  */
-void virtser_send(const uint8_t byte) {
+void virtser_send(const uint8_t byte) { virtser_send_buffer(&byte, 1); }
+
+/** \brief Virtual Serial Send Buffer
+ *
+ * Writes all the bytes before flushing, so that they go out in as few packets as possible.
+ */
+void virtser_send_buffer(const uint8_t *data, uint8_t length) {
     uint8_t timeout = 255;
     uint8_t ep      = Endpoint_GetCurrentEndpoint();
 
@@ -970,7 +1006,7 @@ void virtser_send(const uint8_t byte) {
 
         while (timeout-- && !Endpoint_IsReadWriteAllowed()) _delay_us(40);
 
-        Endpoint_Write_8(byte);
+        Endpoint_Write_Stream_LE(data, length, NULL);
         CDC_Device_Flush(&cdc_device);
 
         if (Endpoint_IsINReady()) {
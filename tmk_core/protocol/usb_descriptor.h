@@ -157,6 +157,8 @@ enum usb_interfaces {
 
 #if defined(MOUSE_ENABLE) && !defined(MOUSE_SHARED_EP)
     MOUSE_INTERFACE,
+#else
+#    define MOUSE_INTERFACE SHARED_INTERFACE
 #endif
 
 #if defined(SHARED_EP_ENABLE) && !defined(KEYBOARD_SHARED_EP)
@@ -81,6 +81,10 @@ enum usb_interfaces {
 #    error Mouse/Extra Keys share an endpoint with Console. Please disable one of the two.
 #endif
 
+#if defined(MOUSE_EXTENDED_REPORT) || defined(MOUSE_HIRES_SCROLL)
+#    error The V-USB mouse report does not support MOUSE_EXTENDED_REPORT or MOUSE_HIRES_SCROLL
+#endif
+
 static uint8_t keyboard_led_state = 0;
 static uint8_t vusb_idle_rate     = 0;
 
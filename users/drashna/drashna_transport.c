@@ -32,8 +32,6 @@
 
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
-static pin_t encoders_pad[] = ENCODERS_PAD_A;
-#    define NUMBER_OF_ENCODERS (sizeof(encoders_pad) / sizeof(pin_t))
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
@@ -65,7 +63,8 @@ typedef struct _I2C_slave_buffer_t {
     rgblight_syncinfo_t rgblight_sync;
 #    endif
 #    ifdef ENCODER_ENABLE
-    uint8_t encoder_state[NUMBER_OF_ENCODERS];
+    encoder_log_t encoder_state;
+    uint8_t       encoder_ack;
 #    endif
 #    ifdef WPM_ENABLE
     uint8_t current_wpm;
@@ -87,6 +86,7 @@ static I2C_slave_buffer_t *const i2c_buffer = (I2C_slave_buffer_t *)i2c_slave_re
 #    define I2C_WEAK_MODS_START offsetof(I2C_slave_buffer_t, weak_mods)
 #    define I2C_ONESHOT_MODS_START offsetof(I2C_slave_buffer_t, oneshot_mods)
 #    define I2C_ENCODER_START offsetof(I2C_slave_buffer_t, encoder_state)
+#    define I2C_ENCODER_ACK_START offsetof(I2C_slave_buffer_t, encoder_ack)
 #    define I2C_WPM_START offsetof(I2C_slave_buffer_t, current_wpm)
 #    define I2C_MOUSE_X_START offsetof(I2C_slave_buffer_t, mouse_x)
 #    define I2C_MOUSE_Y_START offsetof(I2C_slave_buffer_t, mouse_y)
@@ -126,8 +126,14 @@ bool transport_master(matrix_row_t matrix[]) {
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    i2c_readReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_START, (void *)i2c_buffer->encoder_state, sizeof(i2c_buffer->encoder_state), TIMEOUT);
-    encoder_update_raw(i2c_buffer->encoder_state);
+    if (i2c_readReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_START, (void *)&i2c_buffer->encoder_state, sizeof(i2c_buffer->encoder_state), TIMEOUT) >= 0) {
+        uint8_t encoder_ack = encoder_update_raw(&i2c_buffer->encoder_state);
+        if (encoder_ack != i2c_buffer->encoder_ack) {
+            if (i2c_writeReg(SLAVE_I2C_ADDRESS, I2C_ENCODER_ACK_START, (void *)&encoder_ack, sizeof(encoder_ack), TIMEOUT) >= 0) {
+                i2c_buffer->encoder_ack = encoder_ack;
+            }
+        }
+    }
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -226,7 +232,7 @@ void transport_slave(matrix_row_t matrix[]) {
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    encoder_state_raw(i2c_buffer->encoder_state);
+    encoder_state_raw(&i2c_buffer->encoder_state, i2c_buffer->encoder_ack);
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -283,7 +289,7 @@ typedef struct _Serial_s2m_buffer_t {
     // TODO: if MATRIX_COLS > 8 change to uint8_t packed_matrix[] for pack/unpack
     matrix_row_t smatrix[ROWS_PER_HAND];
 #    ifdef ENCODER_ENABLE
-    uint8_t encoder_state[NUMBER_OF_ENCODERS];
+    encoder_log_t encoder_state;
 #    endif
     int8_t mouse_x;
     int8_t mouse_y;
@@ -307,6 +313,9 @@ typedef struct _Serial_m2s_buffer_t {
     layer_state_t t_layer_state;
     layer_state_t t_default_layer_state;
     bool          is_rgb_matrix_suspended;
+#    ifdef ENCODER_ENABLE
+    uint8_t       encoder_ack;
+#    endif
 } __attribute__((packed)) Serial_m2s_buffer_t;
 
 #    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
@@ -406,7 +415,7 @@ bool transport_master(matrix_row_t matrix[]) {
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    encoder_update_raw((uint8_t *)serial_s2m_buffer.encoder_state);
+    serial_m2s_buffer.encoder_ack = encoder_update_raw((encoder_log_t *)&serial_s2m_buffer.encoder_state);
 #    endif
 
 #    ifdef WPM_ENABLE
@@ -457,7 +466,7 @@ void transport_slave(matrix_row_t matrix[]) {
 #    endif
 
 #    ifdef ENCODER_ENABLE
-    encoder_state_raw((uint8_t *)serial_s2m_buffer.encoder_state);
+    encoder_state_raw((encoder_log_t *)&serial_s2m_buffer.encoder_state, serial_m2s_buffer.encoder_ack);
 #    endif
 
 #    ifdef WPM_ENABLE